@@ -0,0 +1,149 @@
+#!/usr/bin/python3
+# Generates the synth lookup tables, so they don't have to be worked out at boot.
+# Run from this directory after changing a table, and commit the output.
+
+import math
+
+OUTPUT_C_FILE = '../src/tables/tables.cpp'
+OUTPUT_H_FILE = '../src/tables/tables.h'
+
+SAMPLE_RATE = 48000
+PARAM_SCALE = 128
+
+EXP_TABLE_SIZE = 1024
+MIDI_NOTE_TABLE_LEN = 128
+CENTS_TABLE_LEN = 100
+CENTS_TABLE_BITS = 31
+SVFREQ_FINE_BITS = 14
+SVFREQ_FINE_TABLE_BITS = 8
+GRAIN_WINDOW_BITS = 8
+FM_SINE_BITS = 11
+
+tables = []
+
+class Table:
+    def __init__(self, name, ctype, values, ram, comment):
+        self.name = name
+        self.ctype = ctype
+        self.values = values
+        # Tables read at audio rate are left non-const, so they go in .data and are
+        # copied to SRAM at boot. The rest are const and stay in flash.
+        self.ram = ram
+        self.comment = comment
+
+def add_table(name, ctype, values, ram=False, comment=''):
+    tables.append(Table(name, ctype, values, ram, comment))
+    where = 'SRAM' if ram else 'flash'
+    print(f"{name} \t-> {ctype}[{len(values)}] in {where}")
+
+
+def svfreq(arg):
+    return 0.1 * arg * math.exp(2.1 * arg)
+
+def q15(x):
+    return max(-32768, min(32767, int(x * 32768)))
+
+def phase_inc(freq):
+    return int(0xFFFFFFFF * (freq / SAMPLE_RATE))
+
+def note_freq(note):
+    # Note 0 is kept for 'no note'
+    if note == 0:
+        return 0.0
+    return 440.0 * 2 ** ((note - 69) / 12)
+
+
+def hann(x):
+    return 0.5 - 0.5 * math.cos(2 * math.pi * x)
+
+def make_tables():
+    add_table('exp_table', 'float',
+        [math.exp(i / EXP_TABLE_SIZE) for i in range(EXP_TABLE_SIZE)],
+        comment='exp(x) for x in 0..1')
+
+    add_table('svfreq_map_table', 'float',
+        [svfreq(i / PARAM_SCALE) for i in range(PARAM_SCALE)], ram=True,
+        comment='Filter cutoff coefficient per parameter step')
+    add_table('svfreq_map_table_q15', 'int16_t',
+        [q15(svfreq(i / PARAM_SCALE)) for i in range(PARAM_SCALE)], ram=True)
+
+    # One extra entry so interpolation doesn't need to check the end
+    fine_len = (1 << SVFREQ_FINE_TABLE_BITS) + 1
+    add_table('svfreq_fine_table', 'float',
+        [svfreq(i / (1 << SVFREQ_FINE_TABLE_BITS)) for i in range(fine_len)], ram=True,
+        comment='Filter cutoff coefficient, for interpolating between parameter steps')
+
+    add_table('note_table', 'uint32_t',
+        [phase_inc(note_freq(n)) for n in range(MIDI_NOTE_TABLE_LEN)],
+        comment='Phase increment per sample for each MIDI note')
+
+    add_table('cents_table', 'uint32_t',
+        [int(2 ** (c / 1200) * (1 << CENTS_TABLE_BITS)) for c in range(CENTS_TABLE_LEN)],
+        comment=f'Frequency ratio for 0..99 cents, with {CENTS_TABLE_BITS} fractional bits')
+
+    # One extra entry so interpolation doesn't need to check the end
+    window_len = (1 << GRAIN_WINDOW_BITS) + 1
+    add_table('grain_window_table', 'int16_t',
+        [q15(hann(i / (1 << GRAIN_WINDOW_BITS))) for i in range(window_len)], ram=True,
+        comment='Hann window for granular playback, Q15')
+
+    # Two cycles, so a phase and a phase offset can be added as table indexes
+    # without wrapping. Full scale, as FM operators modulate with their raw output.
+    sine_len = 1 << FM_SINE_BITS
+    add_table('fm_sine_table', 'int16_t',
+        [q15(math.sin(2 * math.pi * i / sine_len)) for i in range(2 * sine_len)], ram=True,
+        comment='Sine for FM operators, two cycles, Q15')
+
+
+def format_value(ctype, v):
+    if ctype == 'float':
+        s = f"{v:.9g}"
+        if '.' not in s and 'e' not in s:
+            s += '.0'
+        return s + 'f'
+    return f"{v}"
+
+def generate_h_file():
+    hfile = open(OUTPUT_H_FILE, 'w')
+    hfile.write('// Autogenerated file\n')
+    hfile.write('#pragma once\n')
+    hfile.write('#include <stdint.h>\n\n')
+    hfile.write(f"#define EXP_TABLE_SIZE {EXP_TABLE_SIZE}\n")
+    hfile.write(f"#define CENTS_TABLE_LEN {CENTS_TABLE_LEN}\n")
+    hfile.write(f"#define CENTS_TABLE_BITS {CENTS_TABLE_BITS}\n")
+    hfile.write(f"#define SVFREQ_FINE_BITS {SVFREQ_FINE_BITS}\n")
+    hfile.write(f"#define SVFREQ_FINE_TABLE_BITS {SVFREQ_FINE_TABLE_BITS}\n")
+    hfile.write(f"#define GRAIN_WINDOW_BITS {GRAIN_WINDOW_BITS}\n")
+    hfile.write(f"#define FM_SINE_BITS {FM_SINE_BITS}\n\n")
+
+    for table in tables:
+        const = '' if table.ram else 'const '
+        comment = f"\t\t// {table.comment}" if table.comment else ''
+        hfile.write(f"extern {const}{table.ctype} {table.name}[{len(table.values)}];{comment}\n")
+
+def generate_c_file():
+    cfile = open(OUTPUT_C_FILE, 'w')
+    cfile.write('// Autogenerated file\n')
+    cfile.write('#include "tables.h"\n')
+    VALUES_PER_ROW = 8
+
+    for table in tables:
+        const = '' if table.ram else 'const '
+        cfile.write(f'\n{const}{table.ctype} {table.name}[{len(table.values)}] = {{\n')
+        for n,v in enumerate(table.values):
+            cfile.write(format_value(table.ctype, v) + ',')
+            if n%VALUES_PER_ROW == VALUES_PER_ROW-1:
+                cfile.write('\n')
+        if len(table.values) % VALUES_PER_ROW:
+            cfile.write('\n')
+        cfile.write('};\n')
+
+
+def run():
+    make_tables()
+    generate_c_file()
+    generate_h_file()
+
+
+if __name__ == '__main__':
+    run()
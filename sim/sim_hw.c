@@ -4,11 +4,19 @@
 #include "../src/gfx/ngl.h"
 #include "../src/common.h"
 #include <stdio.h>
+#include <string.h>
 #include "raylib.h"
 
+// Button changes waiting for hw_get_button_event()
+#define BUTTON_EVENT_QUEUE_SIZE 32
+
 uint8_t led_value[NUM_LEDS];
 uint8_t btn_value[NUM_BUTTONS];
 
+static ButtonEvent btn_events[BUTTON_EVENT_QUEUE_SIZE];
+static volatile uint32_t btn_event_head;
+static volatile uint32_t btn_event_tail;
+
 int knob_position[NUM_KNOBS] = {1,1,1,1};
 
 void oled_set_brightness(int brightness) {
@@ -42,12 +50,43 @@ bool hw_read_button(int button) {
 }
 
 
+bool hw_get_button_event(ButtonEvent *evt) {
+    const uint32_t tail = btn_event_tail;
+    if (tail == btn_event_head) return false;
+    *evt = btn_events[tail % BUTTON_EVENT_QUEUE_SIZE];
+    btn_event_tail = tail + 1;
+    return true;
+}
+
+
+// Queue the buttons that changed since the last scan. If the queue is full a
+// change is undone, to be seen again on the next scan.
+static void queue_button_changes(const uint8_t *last) {
+    const uint32_t now = time_us_32();
+    for (int i=0; i<NUM_BUTTONS; i++) {
+        if (btn_value[i] == last[i]) continue;
+        const uint32_t head = btn_event_head;
+        if (head - btn_event_tail >= BUTTON_EVENT_QUEUE_SIZE) {
+            btn_value[i] = last[i];
+            continue;
+        }
+        ButtonEvent *evt = &btn_events[head % BUTTON_EVENT_QUEUE_SIZE];
+        evt->time_us = now;
+        evt->button = i;
+        evt->down = btn_value[i];
+        btn_event_head = head + 1;
+    }
+}
+
+
 void delay_us_in_isr(uint32_t us) {
     // not implemented
 }
 
 
 void hw_scan_buttons(void) {
+    uint8_t last[NUM_BUTTONS];
+    memcpy(last, btn_value, sizeof(last));
 
     btn_value[BTN_STEP_1]  = IsKeyDown(KEY_A);
     btn_value[BTN_STEP_2]  = IsKeyDown(KEY_S);
@@ -80,6 +119,8 @@ void hw_scan_buttons(void) {
     btn_value[BTN_MENU]     = IsKeyDown(KEY_Y);
     btn_value[BTN_KEYBOARD] = IsKeyDown(KEY_T);
 
+    queue_button_changes(last);
+
     int knob = 0;
     if (IsKeyDown(KEY_F2)) knob = 1;
     if (IsKeyDown(KEY_F3)) knob = 2;
@@ -16,6 +16,10 @@ int64_t perf_get(int metric) {
     return metric_value[metric];
 }
 
+void perf_set(int metric, int64_t value) {
+    metric_value[metric] = value;
+}
+
 void perf_start(int metric) {
     perfcounter[metric] = 0;//get_absolute_time();
 }
@@ -1,11 +1,9 @@
 #include "pico/multicore.h"
+#include "hardware/sync.h"
 #include "audio.hpp"
 #include "track.hpp"
 #include "common.h"
 
-#define CORE0_CHANNEL_MASK  0b00001111
-#define CORE1_CHANNEL_MASK  0b11110000
-
 extern Track track;
 
 void core1_main(void);
@@ -17,10 +15,29 @@ static int doorbell_core1_finished;
 // The audio_cb InputState is used to control/play the active channel with minimal latency.
 static InputState audio_cb_input_state;
 
-struct {
-    volatile bool audio_done;
+// Number of channels each core rendered in the last buffer
+static int channel_count[NUM_CORES];
+
+// Buffer size, taken at the start of each buffer
+static volatile int buffer_samps = DEFAULT_BUFFER_SIZE_SAMPS;
+
+// Time the last audio callback started, for placing key presses
+static uint32_t last_callback_us;
+
+// Input read by the last audio callback, for the main loop. The callback can
+// interrupt the main loop anywhere, so the main loop copies the input out and
+// checks the sequence number didn't change meanwhile. It is odd during a write.
+static struct {
+    volatile uint32_t seq;
     RawInput input;
-} shared;
+} mailbox;
+
+// Sequence number of the input the main loop last took
+static uint32_t mailbox_taken;
+
+// Core 0 time spent asleep in audio_wait, over the current second
+static uint32_t idle_us;
+static uint32_t idle_window_start;
 
 
 
@@ -44,13 +61,67 @@ static void wait_for_core1(void) {
 }
 
 
+static void mailbox_put(const RawInput &input) {
+    mailbox.seq = mailbox.seq + 1;
+    __compiler_memory_barrier();
+    mailbox.input = input;
+    __compiler_memory_barrier();
+    mailbox.seq = mailbox.seq + 1;
+}
+
+static RawInput mailbox_take(void) {
+    RawInput input;
+    uint32_t seq;
+    do {
+        seq = mailbox.seq;
+        __compiler_memory_barrier();
+        input = mailbox.input;
+        __compiler_memory_barrier();
+    } while ((seq & 1) || seq != mailbox.seq);
+    mailbox_taken = seq;
+    return input;
+}
+
+
 // Wait for audio callback on core 0 to finish
 RawInput audio_wait(void) {
-    // TODO: redo this properly
-    // Wait for end of audio task
-    while (!shared.audio_done);
-    shared.audio_done = 0;
-    return shared.input;
+    // Sleep until the next callback has been. Interrupts are off between the check
+    // and the WFI so a callback can't slip in unseen; a pending interrupt still
+    // wakes the core, and is taken once they are back on. Time asleep is idle time.
+    while (mailbox.seq == mailbox_taken) {
+        const uint32_t save = save_and_disable_interrupts();
+        if (mailbox.seq == mailbox_taken) {
+            const uint32_t sleep_start = time_us_32();
+            __wfi();
+            idle_us += time_us_32() - sleep_start;
+        }
+        restore_interrupts(save);
+    }
+
+    const uint32_t now = time_us_32();
+    if (now - idle_window_start >= 1000000) {
+        perf_set(PERF_IDLE, (int64_t)idle_us * 100 / (now - idle_window_start));
+        idle_us = 0;
+        idle_window_start = now;
+    }
+
+    return mailbox_take();
+}
+
+
+int audio_get_channel_count(int core) {
+    return channel_count[core];
+}
+
+
+bool audio_set_buffer_size(int n) {
+    if (n < MIN_BUFFER_SIZE_SAMPS || n > BUFFER_SIZE_SAMPS || (n & (n - 1))) return false;
+    buffer_samps = n;
+    return true;
+}
+
+int audio_get_buffer_size(void) {
+    return buffer_samps;
 }
 
 
@@ -59,33 +130,68 @@ RawInput audio_wait(void) {
 // - Update parameters for current voice
 // - Generate audio
 extern "C" void audio_dma_callback(void) {
+    perf_start(PERF_AUDIO);
+    const uint32_t callback_us = time_us_32();
+
+    // The size only changes here, between buffers
+    const int n = buffer_samps;
+
+    // The button matrix is scanned by a timer, so this only reads the encoders
     RawInput input = input_read();
     AudioBuffer buffer = get_audio_buffer();
-
-    perf_start(PERF_AUDIO);
+    buffer.sample_count = n;
 
     if (input_process(&audio_cb_input_state, input)) {
         // Change parameters via encoders
-        // Play notes via keyboard
         track.control_active_channel(audio_cb_input_state);
-        track.play_active_channel(audio_cb_input_state);
     }
 
+    // Play notes via keyboard. Each key press or release since the last callback
+    // goes as far into this buffer as it came after the start of the last one, so
+    // every note has the same latency, of about two buffers, whatever the size.
+    ButtonEvent key;
+    while (hw_get_button_event(&key)) {
+        int offset = (int64_t)(int32_t)(key.time_us - last_callback_us) * SAMPLE_RATE / 1000000;
+        CLAMP(offset, 0, n-1);
+        track.play_key(key.button, key.down, offset, audio_cb_input_state);
+    }
+    last_callback_us = callback_us;
+
     // Process channels on both cores
+    track.start_channels(n);
     trigger_core1();
     perf_start(PERF_CHAN_CORE0);
-    track.process_channels(CORE0_CHANNEL_MASK);
+    channel_count[0] = track.process_channels();
     perf_end(PERF_CHAN_CORE0);
-    wait_for_core1();
-    
+
     // Mix channels down into output buffer
+#ifdef MIX_SPLIT_CORES
+    // Core 1 mixes the second half once all the channels are done. The waits for
+    // core 1 are left out of the mix time, so they count as overhead.
+    track.wait_channels();
+    perf_start(PERF_MIX);
+    track.mix(0, n/2);
+    const int64_t mix_us = perf_end(PERF_MIX);
+    wait_for_core1();
+    perf_start(PERF_MIX);
+    track.end_buffer((int16_t *) buffer.samples);
+    perf_set(PERF_MIX, mix_us + perf_end(PERF_MIX));
+#else
+    wait_for_core1();
+    perf_start(PERF_MIX);
     track.downmix(buffer);
+    perf_end(PERF_MIX);
+#endif
+
+    mailbox_put(input);
 
-    shared.input = input;
-    shared.audio_done = 1;
-    
-    perf_end(PERF_AUDIO);
+    // Time not spent rendering or mixing is the fixed cost of each buffer: inputs,
+    // handing over to core 1 and waiting for it, and taking and giving the buffer.
+    // It matters more the smaller the buffer.
     put_audio_buffer(buffer);
+    const int64_t audio_us = perf_end(PERF_AUDIO);
+    perf_set(PERF_AUDIO_OVERHEAD, audio_us - perf_get(PERF_CHAN_CORE0) - perf_get(PERF_MIX));
+    voice_limit_update(audio_us, n);
 }
 
 
@@ -106,8 +212,13 @@ void core1_main(void) {
         // Wait for doorbell
         __wfi();
         perf_start(PERF_CHAN_CORE1);
-        track.process_channels(CORE1_CHANNEL_MASK);
+        channel_count[1] = track.process_channels();
         perf_end(PERF_CHAN_CORE1);
+#ifdef MIX_SPLIT_CORES
+        track.wait_channels();
+        const int n = track.get_buffer_size();
+        track.mix(n/2, n/2);
+#endif
         multicore_doorbell_set_other_core(doorbell_core1_finished);
     }
 }
@@ -1,4 +1,14 @@
 #pragma once
 #include "input.h"
 
+// Sleep until the next audio callback has run, and return the input it read
 RawInput audio_wait(void);
+
+// Number of channels rendered by the given core in the last buffer
+int audio_get_channel_count(int core);
+
+// Buffer size in samples: a power of two from MIN_BUFFER_SIZE_SAMPS to
+// BUFFER_SIZE_SAMPS. Takes effect from the next buffer. Returns false if the
+// size isn't one of these.
+bool audio_set_buffer_size(int n);
+int audio_get_buffer_size(void);
@@ -0,0 +1,248 @@
+#include "benchmark.h"
+#include "common.h"
+#include "synth_common.hpp"
+#include "instrument.hpp"
+#include "track.hpp"
+#include "oversample.hpp"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include <cstring>
+
+// Each kernel is run over this many buffers
+#define BENCH_REPEATS 64
+
+static float fbuf[BUFFER_SIZE_SAMPS];
+static float fmix[BUFFER_SIZE_SAMPS];
+static int16_t qbuf[BUFFER_SIZE_SAMPS];
+static int16_t qout[AUDIO_OUT_CHANNELS*BUFFER_SIZE_SAMPS];
+static int16_t qgain[BUFFER_SIZE_SAMPS];
+static int32_t qacc[BUFFER_SIZE_SAMPS];
+static sample_t chan_buf[BUFFER_SIZE_SAMPS];
+
+// Run func over BENCH_REPEATS buffers with interrupts off and print the cost
+template <typename F>
+static void bench(const char *name, F func) {
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t start = time_us_32();
+    for (int r=0; r<BENCH_REPEATS; r++) {
+        func();
+    }
+    uint32_t elapsed = time_us_32() - start;
+    restore_interrupts(irq);
+
+    const float cycles_per_us = clock_get_hz(clk_sys) / 1000000.0f;
+    const float cycles = elapsed * cycles_per_us / (BENCH_REPEATS * BUFFER_SIZE_SAMPS);
+    printf("  %-16s %6.1f cycles/sample\n", name, cycles);
+}
+
+int dsp_benchmark(int argc, char **argv) {
+    const uint32_t dphase = midi_note_to_freq(45);
+
+    printf("float:\n");
+    bench("saw", [&]() {
+        static uint32_t phase;
+        for (int i=0; i<BUFFER_SIZE_SAMPS; i++) {
+            phase += dphase;
+            fbuf[i] = oscillator_saw(phase, dphase, 0);
+        }
+    });
+    bench("svfilter", [&]() {
+        static SVFilter filter;
+        filter.cutoff = svfreq_map(64);
+        filter.res = 0.5f;
+        for (int i=0; i<BUFFER_SIZE_SAMPS; i++) {
+            fbuf[i] = process_svfilter(&filter, fbuf[i]);
+        }
+    });
+    bench("mix 8ch", [&]() {
+        memset(fmix, 0, sizeof(fmix));
+        for (int v=0; v<NUM_CHANNELS; v++) {
+            for (int i=0; i<BUFFER_SIZE_SAMPS; i++) {
+                fmix[i] += fbuf[i] * 0.2f * 32767;
+            }
+        }
+    });
+    bench("mix 8ch folded", [&]() {
+        static float gain[NUM_CHANNELS];
+        for (int v=0; v<NUM_CHANNELS; v++) gain[v] = 0.5f * 0.2f * 32767;
+        memset(fmix, 0, sizeof(fmix));
+        for (int v=0; v<NUM_CHANNELS; v++) {
+            const float g = gain[v];
+            for (int i=0; i<BUFFER_SIZE_SAMPS; i++) {
+                fmix[i] += fbuf[i] * g;
+            }
+        }
+    });
+
+    printf("q15:\n");
+    bench("saw", [&]() {
+        static uint32_t phase;
+        q15_saw_block(qbuf, &phase, dphase, BUFFER_SIZE_SAMPS);
+    });
+    bench("svfilter", [&]() {
+        static SVFilterQ15 filter;
+        for (int i=0; i<BUFFER_SIZE_SAMPS; i++) qgain[i] = svfreq_map_q15(64);
+        q15_svfilter_block(&filter, qbuf, qgain, 16384, BUFFER_SIZE_SAMPS);
+    });
+    bench("wavetable", [&]() {
+        static uint32_t phase;
+        wavetable_block(qbuf, WT_SAW, &phase, dphase, BUFFER_SIZE_SAMPS);
+    });
+    bench("fm operator", [&]() {
+        static uint32_t phase;
+        static uint32_t mod[BUFFER_SIZE_SAMPS];
+        static int16_t fb_state[2];
+        q15_fm_op_block(qbuf, mod, &phase, dphase, 0, fb_state, BUFFER_SIZE_SAMPS);
+    });
+    bench("noise white", [&]() {
+        noise_white_block(qbuf, BUFFER_SIZE_SAMPS);
+    });
+    bench("noise pink", [&]() {
+        static PinkNoise pink;
+        noise_pink_block(&pink, qbuf, BUFFER_SIZE_SAMPS);
+    });
+    bench("noise s&h", [&]() {
+        static uint32_t phase;
+        static int16_t held;
+        noise_sh_block(qbuf, &phase, dphase, &held, BUFFER_SIZE_SAMPS);
+    });
+    bench("gain", [&]() {
+        q15_mul_block(qbuf, qgain, BUFFER_SIZE_SAMPS);
+    });
+    bench("mix 8ch", [&]() {
+        memset(qacc, 0, sizeof(qacc));
+        for (int v=0; v<NUM_CHANNELS; v++) {
+            q15_mix_block(qacc, qbuf, 1000, BUFFER_SIZE_SAMPS);
+        }
+    });
+    bench("mix 8ch stereo", [&]() {
+        static int32_t acc[2*BUFFER_SIZE_SAMPS];
+        memset(acc, 0, sizeof(acc));
+        for (int v=0; v<NUM_CHANNELS; v++) {
+            q15_mix_stereo_block(acc, qbuf, 1000, 700, BUFFER_SIZE_SAMPS);
+        }
+    });
+
+    // Mix bus with every channel active, using whichever sample format this build uses
+    printf("mix:\n");
+    static Track bench_track;
+    for (int v=0; v<NUM_CHANNELS; v++) {
+        bench_track.channels[v].is_active = true;
+        bench_track.set_channel_volume_percent(v, 80);
+    }
+    bench_track.set_volume_percent(50);
+    bench_track.update_mix_gains();
+    bench("Track::mix", [&]() {
+        bench_track.mix(0, BUFFER_SIZE_SAMPS);
+    });
+    // Loud enough that the limiter is working
+    static mix_t limiter_in[2*BUFFER_SIZE_SAMPS];
+    for (int i=0; i<2*BUFFER_SIZE_SAMPS; i++) limiter_in[i] = 4 * qacc[i/2];
+    bench("limiter", [&]() {
+        static Limiter limiter;
+        limiter.process(limiter_in, qout, BUFFER_SIZE_SAMPS);
+    });
+
+    // PSRAM bursts plus the feedback loop
+    static Delay bench_delay;
+    static mix_t delay_mix[2*BUFFER_SIZE_SAMPS];
+    if (bench_delay.init()) {
+        bench_delay.set_time(SAMPLE_RATE / 4);
+        bench("delay", [&]() {
+            memset(delay_mix, 0, sizeof(delay_mix));
+            bench_delay.process(limiter_in, delay_mix, BUFFER_SIZE_SAMPS);
+        });
+    }
+
+    // The bench track's own reverb, rather than a second copy of its line memory
+    Reverb &bench_reverb = bench_track.reverb;
+    mix_t *reverb_out = bench_track.reverb_out;
+    bench_reverb.init();
+    bench_reverb.set_quality(REVERB_LOW);
+    bench("reverb low", [&]() {
+        bench_reverb.process(limiter_in, reverb_out, BUFFER_SIZE_SAMPS);
+    });
+    bench_reverb.set_quality(REVERB_HIGH);
+    bench("reverb high", [&]() {
+        bench_reverb.process(limiter_in, reverb_out, BUFFER_SIZE_SAMPS);
+    });
+
+    // Up and back down again, per control period as the instruments do it
+    printf("oversample:\n");
+    static Oversampler bench_os;
+    static sample_t os_buf[OVERSAMPLE_MAX * OVERSAMPLE_MAX_SAMPS];
+    bench_os.init(2);
+    bench("2x", [&]() {
+        for (int pos=0; pos<BUFFER_SIZE_SAMPS; pos+=OVERSAMPLE_MAX_SAMPS) {
+            bench_os.up(&chan_buf[pos], os_buf, OVERSAMPLE_MAX_SAMPS);
+            bench_os.down(os_buf, &chan_buf[pos], OVERSAMPLE_MAX_SAMPS);
+        }
+    });
+    bench_os.init(4);
+    bench("4x", [&]() {
+        for (int pos=0; pos<BUFFER_SIZE_SAMPS; pos+=OVERSAMPLE_MAX_SAMPS) {
+            bench_os.up(&chan_buf[pos], os_buf, OVERSAMPLE_MAX_SAMPS);
+            bench_os.down(os_buf, &chan_buf[pos], OVERSAMPLE_MAX_SAMPS);
+        }
+    });
+
+    // Whole instrument, using whichever sample format this build uses
+    printf("instruments:\n");
+    static AcidBass bench_acid;
+    bench_acid.init();
+    bench_acid.note_freq = dphase;
+    bench_acid.gate = 1;
+    bench_acid.trigger = 1;
+    bench("AcidBass", [&]() {
+        bench_acid.process_block(chan_buf, BUFFER_SIZE_SAMPS);
+    });
+
+    static PolySynth bench_poly;
+    bench_poly.init();
+    for (int v=0; v<4; v++) bench_poly.note_on(45 + 4*v, false, true);
+    bench("PolySynth 4v", [&]() {
+        bench_poly.process_block(chan_buf, BUFFER_SIZE_SAMPS);
+    });
+    bench_poly.silence();
+    while (!bench_poly.is_idle()) bench_poly.process_block(chan_buf, BUFFER_SIZE_SAMPS);
+
+    // Every drum sounding at once, retriggered so none of them decay away
+    static DrumSynth bench_drums;
+    bench_drums.init();
+    bench("DrumSynth all", [&]() {
+        for (int note : {36, 38, 39, 46}) bench_drums.note_on(note, true, true);
+        bench_drums.process_block(chan_buf, BUFFER_SIZE_SAMPS);
+    });
+    bench_drums.silence();
+
+    static FMSynth bench_fm;
+    bench_fm.init();
+    bench_fm.set_param(FM_PARAM_ALGORITHM, PARAM_MAX);
+    bench_fm.set_param(FM_PARAM_FEEDBACK, 64);
+    for (int v=0; v<4; v++) bench_fm.note_on(45 + 4*v, false, true);
+    bench("FMSynth 4v 4op", [&]() {
+        bench_fm.process_block(chan_buf, BUFFER_SIZE_SAMPS);
+    });
+    bench_fm.silence();
+    while (!bench_fm.is_idle()) bench_fm.process_block(chan_buf, BUFFER_SIZE_SAMPS);
+
+    // Dense enough that the whole grain budget is in use
+    if (SampleManager::sample_list.size() > 0 && SampleManager::load(SampleManager::sample_list[0].sample_id) == 0) {
+        static Granular bench_gran;
+        bench_gran.init();
+        bench_gran.set_param(GR_PARAM_SAMPLE, 0);
+        bench_gran.set_param(GR_PARAM_DENSITY, PARAM_MAX);
+        bench_gran.set_param(GR_PARAM_SIZE, PARAM_MAX);
+        bench_gran.set_param(GR_PARAM_GRAINS, PARAM_MAX);
+        bench_gran.note_on(67, false, true);
+        for (int i=0; i<8; i++) bench_gran.process_block(chan_buf, BUFFER_SIZE_SAMPS);
+        bench("Granular 16 grains", [&]() {
+            bench_gran.process_block(chan_buf, BUFFER_SIZE_SAMPS);
+        });
+    }
+
+    // What each channel gets if the channels are shared evenly between both cores
+    printf("one channel's share: %.1f cycles/sample\n", 2.0f * clock_get_hz(clk_sys) / SAMPLE_RATE / NUM_CHANNELS);
+
+    return 0;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Time the DSP kernels on the device and print cycles per sample
+int dsp_benchmark(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
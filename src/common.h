@@ -14,8 +14,25 @@
 // Output sample rate
 #define SAMPLE_RATE 48000
 
-// Buffer size in samples
+// Largest buffer size in samples, which all the buffers are sized for. The size
+// in use is set at runtime (audio_set_buffer_size), from the smallest up to this,
+// in powers of two. Smaller buffers give lower latency at more overhead per sample.
 #define BUFFER_SIZE_SAMPS 256
+#define MIN_BUFFER_SIZE_SAMPS 32
+#define DEFAULT_BUFFER_SIZE_SAMPS 256
+
+// Output is interleaved stereo, so audio buffers hold this many int16 per sample
+#define AUDIO_OUT_CHANNELS 2
+
+// Use 16-bit fixed point (Q15) DSP kernels for instruments and mixing.
+// These use the Cortex-M33 DSP extension. Define AUDIO_FLOAT (or comment
+// this out) to use floating point.
+#ifndef AUDIO_FLOAT
+#define AUDIO_Q15
+#endif
+
+// Share the mixdown between both cores, each mixing half of the buffer
+#define MIX_SPLIT_CORES
 
 /************************************************/
 
@@ -27,8 +44,6 @@
 
 
 
-#define BUFFER_TIME_SEC ((BUFFER_SIZE_SAMPS) / (float)(SAMPLE_RATE))
-
 // Show min and max sample values
 //#define DEBUG_AMPLITUDE
 
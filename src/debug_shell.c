@@ -8,6 +8,7 @@
 #include "hw/psram_spi.h"
 #include "hw/hw.h"
 #include "hw/pinmap.h"
+#include "benchmark.h"
 
 void write_char(char c) {
     putchar(c);
@@ -224,6 +225,7 @@ void debug_shell(void) {
     ADD_CMD("msc", "mass storage mode", enter_msc);
     ADD_CMD("ledtest", "led test", led_test);
     ADD_CMD("ramw", "psram write", psram_write_test);
+    ADD_CMD("dspbench", "DSP benchmark", dsp_benchmark);
 
     prompt();
 }
\ No newline at end of file
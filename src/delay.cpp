@@ -0,0 +1,106 @@
+#include <string.h>
+#include "delay.hpp"
+#include "hw/hw.h"
+#include "hw/psram_spi.h"
+
+bool Delay::init() {
+    if (addr < 0) {
+        addr = psram_alloc(DELAY_MAX_SAMPS * sizeof(int16_t));
+        if (addr < 0) return false;
+    }
+
+    memset(line_in, 0, sizeof(line_in));
+    for (int pos=0; pos<DELAY_MAX_SAMPS; pos+=BUFFER_SIZE_SAMPS) {
+        const int n = (DELAY_MAX_SAMPS - pos < BUFFER_SIZE_SAMPS) ? DELAY_MAX_SAMPS - pos : BUFFER_SIZE_SAMPS;
+        line_write(pos, line_in, n);
+    }
+    write_pos = 0;
+    lp = 0;
+
+    set_feedback(0.4f);
+    set_tone(0.5f);
+    set_level(0.5f);
+    return true;
+}
+
+void Delay::set_time(int samps) {
+    CLAMP(samps, DELAY_MIN_SAMPS, DELAY_MAX_SAMPS);
+    // Keep blocks word aligned in PSRAM
+    time = samps & ~1;
+}
+
+void Delay::set_feedback(float fb) {
+    CLAMP(fb, 0.0f, 0.95f);
+#ifdef AUDIO_Q15
+    feedback = fb * 32768;
+#else
+    feedback = fb;
+#endif
+}
+
+void Delay::set_tone(float t) {
+    CLAMP(t, 0.02f, 1.0f);
+#ifdef AUDIO_Q15
+    tone = t * 32767;
+#else
+    tone = t;
+#endif
+}
+
+void Delay::set_level(float lvl) {
+    CLAMP(lvl, 0.0f, 1.0f);
+#ifdef AUDIO_Q15
+    level = lvl * (1 << Q15_MIX_GAIN_BITS);
+#else
+    level = lvl;
+#endif
+}
+
+
+// Bursts of n samples at a line position, in two parts if they wrap around
+void Delay::line_read(uint32_t pos, int16_t *buf, int n) {
+    const int first = (DELAY_MAX_SAMPS - pos < (uint32_t)n) ? DELAY_MAX_SAMPS - pos : n;
+    psram_read(addr + pos * sizeof(int16_t), (uint8_t*)buf, first * sizeof(int16_t));
+    if (first < n) {
+        psram_read(addr, (uint8_t*)&buf[first], (n - first) * sizeof(int16_t));
+    }
+}
+
+void Delay::line_write(uint32_t pos, int16_t *buf, int n) {
+    const int first = (DELAY_MAX_SAMPS - pos < (uint32_t)n) ? DELAY_MAX_SAMPS - pos : n;
+    psram_write(addr + pos * sizeof(int16_t), (uint8_t*)buf, first * sizeof(int16_t));
+    if (first < n) {
+        psram_write(addr, (uint8_t*)&buf[first], (n - first) * sizeof(int16_t));
+    }
+}
+
+void Delay::process(const mix_t *send, mix_t *mix, int n) {
+    if (addr < 0) return;
+
+    const uint32_t read_pos = (write_pos + DELAY_MAX_SAMPS - time) % DELAY_MAX_SAMPS;
+    line_read(read_pos, tap, n);
+
+    for (int i=0; i<n; i++) {
+#ifdef AUDIO_Q15
+        const int32_t y = tap[i];
+        lp += q15_mul32((y << DELAY_TONE_BITS) - lp, tone);
+        const int32_t in = (send[i] >> Q15_MIX_GAIN_BITS) + q15_mul32(lp >> DELAY_TONE_BITS, feedback);
+        line_in[i] = q15_sat(in);
+
+        const int32_t wet = y * level;
+#else
+        const float y = tap[i];
+        lp += (y - lp) * tone;
+        float in = send[i] + lp * feedback;
+        CLAMP(in, -32767.0f, 32767.0f);
+        line_in[i] = (int16_t)in;
+
+        const float wet = y * level;
+#endif
+        mix[2*i]   += wet;
+        mix[2*i+1] += wet;
+    }
+
+    line_write(write_pos, line_in, n);
+    write_pos = (write_pos + n) % DELAY_MAX_SAMPS;
+}
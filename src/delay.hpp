@@ -0,0 +1,57 @@
+#pragma once
+#include "synth_common.hpp"
+#include "limiter.hpp"
+
+// Send delay, with the delay line in PSRAM.
+//
+// The line holds 16-bit samples at output scale. Once per buffer the block coming out
+// of the line is read in one burst, and the send plus filtered feedback going in is
+// written back in another, so the PSRAM is used twice per buffer rather than twice per
+// sample. Since the block read has to have been written already, the delay can't be
+// shorter than a buffer.
+
+#define DELAY_MAX_SAMPS (2 * SAMPLE_RATE)
+#define DELAY_MIN_SAMPS BUFFER_SIZE_SAMPS
+
+// Fractional bits of the feedback filter state
+#define DELAY_TONE_BITS 8
+
+class Delay {
+public:
+    // Allocate and clear the line in PSRAM. Returns false if there isn't room.
+    bool init();
+
+    // Delay in samples, DELAY_MIN_SAMPS..DELAY_MAX_SAMPS
+    void set_time(int samps);
+    // Fraction of the output fed back, below 1
+    void set_feedback(float fb);
+    // Lowpass on the feedback, 0 (dark) to 1 (unfiltered)
+    void set_tone(float tone);
+    // Level of the delayed signal in the mix, at the same scale as the send
+    void set_level(float level);
+
+    // Feed a buffer of n samples of send into the line, and add what comes out into
+    // the interleaved stereo mix
+    void process(const mix_t *send, mix_t *mix, int n);
+
+private:
+    int32_t addr {-1};
+    uint32_t write_pos;
+    int time {DELAY_MIN_SAMPS};
+#ifdef AUDIO_Q15
+    int32_t feedback;       // Q15
+    int32_t tone;           // Q15
+    int16_t level;          // Q15_MIX_GAIN_BITS
+    int32_t lp;             // DELAY_TONE_BITS fractional bits
+#else
+    float feedback;
+    float tone;
+    float level;
+    float lp;
+#endif
+    int16_t tap[BUFFER_SIZE_SAMPS];
+    int16_t line_in[BUFFER_SIZE_SAMPS];
+
+    void line_read(uint32_t pos, int16_t *buf, int n);
+    void line_write(uint32_t pos, int16_t *buf, int n);
+};
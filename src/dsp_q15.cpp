@@ -0,0 +1,203 @@
+#include "dsp_q15.hpp"
+#include "synth_common.hpp"
+
+// The FM operators use the interpolator on the device. The tests build that path
+// on the host too, against a model of it, to check it against the plain C one.
+#ifndef FM_USE_INTERP
+#define FM_USE_INTERP PICO_ON_DEVICE
+#endif
+#if FM_USE_INTERP
+#include "hardware/interp.h"
+#endif
+
+
+static inline int32_t saw_sample(uint32_t phase, uint32_t dphase) {
+    int32_t out = (int32_t)(phase >> 16) - 32768;
+    // Only a couple of samples per cycle need the correction, so it stays in float
+    if (phase < dphase || phase > UINT32_MAX - dphase) {
+        out -= (int32_t)(polyblep(phase, dphase) * 32768.0f);
+    }
+    return q15_sat(out);
+}
+
+void q15_saw_block(int16_t *out, uint32_t *phase, uint32_t dphase, int n) {
+    uint32_t p = *phase;
+    int i = 0;
+    for (; i+1<n; i+=2) {
+        uint32_t p0 = p + dphase;
+        uint32_t p1 = p0 + dphase;
+        q15x2_store(&out[i], q15x2_pack(saw_sample(p0, dphase), saw_sample(p1, dphase)));
+        p = p1;
+    }
+    if (i < n) {
+        p += dphase;
+        out[i] = saw_sample(p, dphase);
+    }
+    *phase = p;
+}
+
+void q15_mul_block(int16_t *buf, const int16_t *gain, int n) {
+    int i = 0;
+    for (; i+1<n; i+=2) {
+        q15x2_t x = q15x2_load(&buf[i]);
+        q15x2_t g = q15x2_load(&gain[i]);
+        int32_t lo = q15_mul_lo(x, g) >> 15;
+        int32_t hi = q15_mul_hi(x, g) >> 15;
+        q15x2_store(&buf[i], q15x2_pack(lo, hi));
+    }
+    if (i < n) {
+        buf[i] = (buf[i] * gain[i]) >> 15;
+    }
+}
+
+void q15_mix_block(int32_t *acc, const int16_t *in, int16_t gain, int n) {
+    int i = 0;
+    for (; i+1<n; i+=2) {
+        q15x2_t x = q15x2_load(&in[i]);
+        acc[i]   = q15_mac_lo(x, gain, acc[i]);
+        acc[i+1] = q15_mac_hi(x, gain, acc[i+1]);
+    }
+    if (i < n) {
+        acc[i] += in[i] * gain;
+    }
+}
+
+void q15_mix_stereo_block(int32_t *acc, const int16_t *in, int16_t gain_l, int16_t gain_r, int n) {
+    int i = 0;
+    for (; i+1<n; i+=2) {
+        q15x2_t x = q15x2_load(&in[i]);
+        int32_t *a = &acc[2*i];
+        a[0] = q15_mac_lo(x, gain_l, a[0]);
+        a[1] = q15_mac_lo(x, gain_r, a[1]);
+        a[2] = q15_mac_hi(x, gain_l, a[2]);
+        a[3] = q15_mac_hi(x, gain_r, a[3]);
+    }
+    if (i < n) {
+        acc[2*i]   += in[i] * gain_l;
+        acc[2*i+1] += in[i] * gain_r;
+    }
+}
+
+void q15_ramp_block(int16_t *out, int32_t *state, int32_t target, int n) {
+    const int64_t end = (int64_t)target << 16;
+    int32_t v = *state;
+    const int32_t step = (end - v) / n;
+    for (int i=0; i<n; i++) {
+        v += step;
+        out[i] = v >> 16;
+    }
+    *state = end;
+}
+
+void q15_svfilter_block(SVFilterQ15 *f, int16_t *buf, const int16_t *cutoff, int32_t kq, int n) {
+    int32_t lp0 = f->lp0;
+    int32_t bp0 = f->bp0;
+    int32_t lp = f->lp;
+    int32_t bp = f->bp;
+
+    for (int i=0; i<n; i++) {
+        const int32_t in = buf[i] << (Q15_SVF_STATE_BITS - 15);
+        const int32_t kf = cutoff[i];
+
+        lp0 += q15_mul32(bp0, kf);
+        int32_t hp0 = in - lp0 - q15_mul32(bp0, kq);
+        bp0 += q15_mul32(hp0, kf);
+
+        lp += q15_mul32(bp, kf);
+        int32_t hp1 = lp0 - lp - q15_mul32(bp, kq);
+        bp += q15_mul32(hp1, kf);
+
+        buf[i] = q15_sat(lp >> (Q15_SVF_STATE_BITS - 15 + Q15_HEADROOM_BITS));
+    }
+
+    f->lp0 = lp0;
+    f->bp0 = bp0;
+    f->lp = lp;
+    f->bp = bp;
+}
+
+
+// Both FM lookups index the two cycle table with the top FM_SINE_BITS of the phase
+// and of the offset, as byte offsets, then add: the sum can't run off the end.
+#define FM_INDEX_SHIFT (31 - FM_SINE_BITS)
+#define FM_INDEX_MASK (((1u << FM_SINE_BITS) - 1) << 1)
+
+static inline int32_t fm_feedback(int16_t fb, const int16_t *y) {
+    return (((y[0] + y[1]) >> 1) * fb) >> 15;
+}
+
+#if FM_USE_INTERP
+
+// Lane 0 accumulates the phase (BASE0 is added on each pop), lane 1 takes the phase
+// offset written to ACCUM1, and the FULL result is BASE2 plus both table offsets.
+// Nothing else uses interp1, so it is set up afresh each time rather than saved.
+static inline void fm_interp_setup(uint32_t phase, uint32_t dphase) {
+    interp_config cfg = interp_default_config();
+    interp_config_set_add_raw(&cfg, true);
+    interp_config_set_shift(&cfg, FM_INDEX_SHIFT);
+    interp_config_set_mask(&cfg, 1, FM_SINE_BITS);
+    interp_set_config(interp1, 0, &cfg);
+
+    cfg = interp_default_config();
+    interp_config_set_shift(&cfg, FM_INDEX_SHIFT);
+    interp_config_set_mask(&cfg, 1, FM_SINE_BITS);
+    interp_set_config(interp1, 1, &cfg);
+
+    interp1->accum[0] = phase;
+    interp1->base[0] = dphase;
+    interp1->base[1] = 0;
+    interp1->base[2] = (uintptr_t)fm_sine_table;
+}
+
+void q15_fm_op_block(int16_t *out, const uint32_t *mod, uint32_t *phase, uint32_t dphase,
+                     int16_t fb, int16_t *fb_state, int n) {
+    fm_interp_setup(*phase, dphase);
+
+    if (fb) {
+        for (int i=0; i<n; i++) {
+            interp1->accum[1] = mod[i] + ((uint32_t)fm_feedback(fb, fb_state) << FM_MOD_SHIFT);
+            const int16_t y = *(const int16_t *)interp1->pop[2];
+            fb_state[1] = fb_state[0];
+            fb_state[0] = y;
+            out[i] = y;
+        }
+    } else {
+        for (int i=0; i<n; i++) {
+            interp1->accum[1] = mod[i];
+            out[i] = *(const int16_t *)interp1->pop[2];
+        }
+    }
+
+    *phase = interp1->accum[0];
+}
+
+#else
+
+static inline int16_t fm_lookup(uint32_t phase, uint32_t offset) {
+    const uint32_t idx = ((phase >> FM_INDEX_SHIFT) & FM_INDEX_MASK) + ((offset >> FM_INDEX_SHIFT) & FM_INDEX_MASK);
+    return *(const int16_t *)((const uint8_t *)fm_sine_table + idx);
+}
+
+void q15_fm_op_block(int16_t *out, const uint32_t *mod, uint32_t *phase, uint32_t dphase,
+                     int16_t fb, int16_t *fb_state, int n) {
+    uint32_t p = *phase;
+
+    if (fb) {
+        for (int i=0; i<n; i++) {
+            const int16_t y = fm_lookup(p, mod[i] + ((uint32_t)fm_feedback(fb, fb_state) << FM_MOD_SHIFT));
+            fb_state[1] = fb_state[0];
+            fb_state[0] = y;
+            out[i] = y;
+            p += dphase;
+        }
+    } else {
+        for (int i=0; i<n; i++) {
+            out[i] = fm_lookup(p, mod[i]);
+            p += dphase;
+        }
+    }
+
+    *phase = p;
+}
+
+#endif
@@ -0,0 +1,146 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+// 16-bit fixed point DSP kernels.
+// Samples are loaded and stored two at a time, one per half of a 32-bit word.
+// On the Cortex-M33 each half then goes through the DSP extension halfword
+// multiplies (SMULBB/SMULTT, SMLABB/SMLATB) and SSAT, with no unpacking.
+// These are still one multiply per sample: the mix keeps a 32-bit
+// accumulator per output sample, so the dual MACs (SMLAD) don't apply.
+// Elsewhere (the simulator, host builds) they fall back to plain C with
+// identical results.
+
+#if defined(__ARM_FEATURE_SAT) || defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
+// Channel buffers hold Q15 values scaled down by this many bits, which leaves
+// headroom for resonant peaks: full scale is +/-4.0
+#define Q15_HEADROOM_BITS 2
+#define Q15_CHANNEL_ONE (32768 >> Q15_HEADROOM_BITS)
+
+// Mix gains are fixed point with this many fractional bits. This is small enough
+// that all channels can be summed into 32-bit accumulators without overflow.
+#define Q15_MIX_GAIN_BITS 12
+
+// Filter state is kept in 32 bits with this many fractional bits
+#define Q15_SVF_STATE_BITS 24
+
+
+// Two Q15 values packed in one word, first sample in the low half
+typedef uint32_t q15x2_t;
+
+static inline int32_t q15_sat(int32_t x) {
+#if defined(__ARM_FEATURE_SAT)
+    return __ssat(x, 16);
+#else
+    if (x > INT16_MAX) return INT16_MAX;
+    if (x < INT16_MIN) return INT16_MIN;
+    return x;
+#endif
+}
+
+static inline int16_t q15_from_float(float x) {
+    return q15_sat((int32_t)(x * 32768.0f));
+}
+
+// Unaligned pair load/store, a single LDR/STR on the M33
+static inline q15x2_t q15x2_load(const int16_t *p) {
+    q15x2_t x;
+    memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+static inline void q15x2_store(int16_t *p, q15x2_t x) {
+    memcpy(p, &x, sizeof(x));
+}
+
+static inline q15x2_t q15x2_pack(int32_t lo, int32_t hi) {
+    return (uint16_t)lo | ((uint32_t)hi << 16);
+}
+
+static inline int32_t q15x2_lo(q15x2_t x) { return (int16_t)x; }
+static inline int32_t q15x2_hi(q15x2_t x) { return (int32_t)x >> 16; }
+
+// acc + x.lo * g (SMLABB) and acc + x.hi * g (SMLATB)
+static inline int32_t q15_mac_lo(q15x2_t x, int16_t g, int32_t acc) {
+#if defined(__ARM_FEATURE_DSP)
+    return __smlabb(x, g, acc);
+#else
+    return acc + q15x2_lo(x) * g;
+#endif
+}
+
+static inline int32_t q15_mac_hi(q15x2_t x, int16_t g, int32_t acc) {
+#if defined(__ARM_FEATURE_DSP)
+    return __smlatb(x, g, acc);
+#else
+    return acc + q15x2_hi(x) * g;
+#endif
+}
+
+// x.lo * y.lo (SMULBB) and x.hi * y.hi (SMULTT)
+static inline int32_t q15_mul_lo(q15x2_t x, q15x2_t y) {
+#if defined(__ARM_FEATURE_DSP)
+    return __smulbb(x, y);
+#else
+    return q15x2_lo(x) * q15x2_lo(y);
+#endif
+}
+
+static inline int32_t q15_mul_hi(q15x2_t x, q15x2_t y) {
+#if defined(__ARM_FEATURE_DSP)
+    return __smultt(x, y);
+#else
+    return q15x2_hi(x) * q15x2_hi(y);
+#endif
+}
+
+// 32-bit by Q15 multiply, for filter state
+static inline int32_t q15_mul32(int32_t a, int32_t b) {
+    return (int32_t)(((int64_t)a * b) >> 15);
+}
+
+
+
+// Naive sawtooth with polyBLEP correction around the discontinuity, full scale
+void q15_saw_block(int16_t *out, uint32_t *phase, uint32_t dphase, int n);
+
+// Multiply by a per-sample Q15 gain (e.g. an envelope)
+void q15_mul_block(int16_t *buf, const int16_t *gain, int n);
+
+// Accumulate in * gain into acc. gain has Q15_MIX_GAIN_BITS fractional bits.
+void q15_mix_block(int32_t *acc, const int16_t *in, int16_t gain, int n);
+
+// Accumulate in * gain_l and in * gain_r into interleaved stereo acc (2n values),
+// in one pass over the input
+void q15_mix_stereo_block(int32_t *acc, const int16_t *in, int16_t gain_l, int16_t gain_r, int n);
+
+// Linear ramp from *state to target over n samples, for control rate values.
+// state is a Q15 value with 16 extra fractional bits, and is left at target.
+void q15_ramp_block(int16_t *out, int32_t *state, int32_t target, int n);
+
+
+// FM operator: out[i] = sin(phase + mod[i] + feedback), advancing phase by dphase per
+// sample, from a table with FM_SINE_BITS of phase. mod holds phase offsets in the same
+// units as phase. Feedback is fb (Q15) times the mean of the last two outputs, shifted
+// up by FM_MOD_SHIFT, with the outputs kept in fb_state[2].
+// On the device the phase accumulation and table addressing are done by the SIO
+// interpolator (interp1) of the calling core.
+#define FM_MOD_SHIFT 18
+void q15_fm_op_block(int16_t *out, const uint32_t *mod, uint32_t *phase, uint32_t dphase,
+                     int16_t fb, int16_t *fb_state, int n);
+
+
+// Fixed point version of the two-stage SVFilter
+struct SVFilterQ15 {
+    int32_t lp0;
+    int32_t bp0;
+    int32_t lp;
+    int32_t bp;
+};
+
+// Filter a full scale Q15 buffer in place with per-sample Q15 cutoff and fixed damping.
+// Output is scaled down by Q15_HEADROOM_BITS.
+void q15_svfilter_block(SVFilterQ15 *f, int16_t *buf, const int16_t *cutoff, int32_t kq, int n);
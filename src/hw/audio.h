@@ -14,16 +14,18 @@ audio_format_t audio_format;
 struct audio_buffer_pool *init_audio(uint32_t sample_rate, uint8_t pin_data, uint8_t pin_bclk, uint8_t pio_sm, uint8_t dma_ch) {
     audio_format.sample_freq = sample_rate;
     audio_format.format = AUDIO_BUFFER_FORMAT_PCM_S16;
-    audio_format.channel_count = 1;
+    audio_format.channel_count = AUDIO_OUT_CHANNELS;
 
   static struct audio_buffer_format producer_format = {
     .format = &audio_format,
-    .sample_stride = 2
+    .sample_stride = 2 * AUDIO_OUT_CHANNELS
   };
 
+  // Two buffers, one playing while the other is rendered. They go straight to the
+  // DMA at whatever length was rendered, so the buffer size can change at runtime.
   struct audio_buffer_pool *producer_pool = audio_new_producer_pool(
     &producer_format,
-    1,
+    2,
     BUFFER_SIZE_SAMPS
   );
 
@@ -41,7 +43,7 @@ struct audio_buffer_pool *init_audio(uint32_t sample_rate, uint8_t pin_data, uin
     panic("PicoAudio: Unable to open audio device.\n");
   }
 
-  bool status = audio_i2s_connect(producer_pool);
+  bool status = audio_i2s_connect_extra(producer_pool, false, 0, BUFFER_SIZE_SAMPS, NULL);
   if (!status) {
     panic("PicoAudio: Unable to connect to audio device.\n");
   }
@@ -3,6 +3,8 @@
 #include "hardware/clocks.h"
 #include "hardware/gpio.h"
 #include "hardware/pwm.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
 #include "hw.h"
 #include "quadrature_encoder.pio.h"
 #include "codec.h"
@@ -17,7 +19,17 @@
 const int PWM_SYSCLK_DIVISOR = 16;
 
 #define NUM_COLUMNS 8
-#define LED_TIMER_UPDATE_HZ 100
+
+// The button and LED matrix is scanned from a timer rather than the audio
+// callback, so it costs the same whatever the buffer size. Button changes are
+// timestamped to within one scan.
+#define LED_TIMER_UPDATE_HZ 2000
+
+// Button changes waiting for hw_get_button_event()
+#define BUTTON_EVENT_QUEUE_SIZE 32
+
+// Changes within this long of a button's last accepted one are contact bounce
+#define BUTTON_DEBOUNCE_US 5000
 
 static bool led_timer_callback(repeating_timer_t *rt);
 static void led_timer_start(void);
@@ -25,10 +37,17 @@ static void matrix_init(void);
 static void psram_init(void);
 extern void multicore_init(void);
 
+static alarm_pool_t *led_timer_pool;
 static repeating_timer_t led_timer;
 static int led_row;
 static uint8_t led_value[NUM_LEDS];
 static uint8_t btn_value[NUM_BUTTONS];
+static uint32_t btn_time[NUM_BUTTONS];     // of the last accepted change
+
+// Written by the scan only at head, read by hw_get_button_event() only at tail
+static ButtonEvent btn_events[BUTTON_EVENT_QUEUE_SIZE];
+static volatile uint32_t btn_event_head;
+static volatile uint32_t btn_event_tail;
 
 static struct audio_buffer_pool *audio_pool;
 static struct audio_buffer *current_audio_buffer;
@@ -54,6 +73,7 @@ void hw_init(void) {
 
     // Input & LED matrix
     matrix_init();
+    led_timer_start();
 
     // Encoders
     pio_set_gpio_base(ENCODER_PIO, 16);
@@ -208,27 +228,74 @@ static void matrix_init(void) {
 }
 
 
+static bool led_timer_callback(repeating_timer_t *rt) {
+    hw_scan_matrix();
+    return true;
+}
+
+
+static void led_timer_start(void) {
+    // The timer gets its own alarm, at the highest priority, so the scan can interrupt
+    // the audio callback: key presses are then timestamped when they happen.
+    led_timer_pool = alarm_pool_create_with_unused_hardware_alarm(1);
+    irq_set_priority(hardware_alarm_get_irq_num(alarm_pool_timer_alarm_num(led_timer_pool)), PICO_HIGHEST_IRQ_PRIORITY);
+
+    // Negative delay: from the start of one callback to the next, so it doesn't drift
+    alarm_pool_add_repeating_timer_us(led_timer_pool, -1000000 / LED_TIMER_UPDATE_HZ, led_timer_callback, NULL, &led_timer);
+}
+
+
 void delay_us_in_isr(uint32_t us) {
     int64_t now = get_absolute_time();
     while (get_absolute_time() - now < us);
 }
 
 
+// Record a button's state, queueing an event if it has changed.
+// A change is ignored for BUTTON_DEBOUNCE_US after the last one, and left for
+// a later scan if the queue is full, so btn_value always matches the queue.
+static void update_button(int button, bool down, uint32_t time_us) {
+    if (btn_value[button] == down) return;
+    if (time_us - btn_time[button] < BUTTON_DEBOUNCE_US) return;
+
+    const uint32_t head = btn_event_head;
+    if (head - btn_event_tail >= BUTTON_EVENT_QUEUE_SIZE) return;
+
+    btn_value[button] = down;
+    btn_time[button] = time_us;
+
+    ButtonEvent *evt = &btn_events[head % BUTTON_EVENT_QUEUE_SIZE];
+    evt->time_us = time_us;
+    evt->button = button;
+    evt->down = down;
+    __compiler_memory_barrier();
+    btn_event_head = head + 1;
+}
+
+
+bool hw_get_button_event(ButtonEvent *evt) {
+    const uint32_t tail = btn_event_tail;
+    if (tail == btn_event_head) return false;
+    __compiler_memory_barrier();
+    *evt = btn_events[tail % BUTTON_EVENT_QUEUE_SIZE];
+    __compiler_memory_barrier();
+    btn_event_tail = tail + 1;
+    return true;
+}
+
+
 void hw_scan_matrix(void) {
+    const uint32_t now = time_us_32();
+
     // Read switches
     set_led_row(-1);
     column_setup_switches();
     for (int row=0; row<4; row++) {
         set_sw_row(row);
-        sleep_us(2);
-        btn_value[8*row+0] = gpio_get(PIN_COL0);
-        btn_value[8*row+1] = gpio_get(PIN_COL1);
-        btn_value[8*row+2] = gpio_get(PIN_COL2);
-        btn_value[8*row+3] = gpio_get(PIN_COL3);
-        btn_value[8*row+4] = gpio_get(PIN_COL4);
-        btn_value[8*row+5] = gpio_get(PIN_COL5);
-        btn_value[8*row+6] = gpio_get(PIN_COL6);
-        btn_value[8*row+7] = gpio_get(PIN_COL7);
+        delay_us_in_isr(2);
+        for (int col=0; col<NUM_COLUMNS; col++) {
+            update_button(NUM_COLUMNS*row + col, gpio_get(PIN_COL0 + col), now);
+        }
     }
     
     // LEDs
@@ -265,7 +332,7 @@ AudioBuffer get_audio_buffer(void) {
 
 void put_audio_buffer(AudioBuffer buffer) {
     current_audio_buffer->buffer->bytes = (uint8_t*)buffer.samples;
-    current_audio_buffer->sample_count = current_audio_buffer->max_sample_count;
+    current_audio_buffer->sample_count = buffer.sample_count;
 
     give_audio_buffer(audio_pool, current_audio_buffer);
     current_audio_buffer = NULL;
@@ -59,6 +59,13 @@ typedef struct {
     uint32_t sample_count;
 } AudioBuffer;
 
+// A button being pressed or released
+typedef struct {
+    uint32_t time_us;   // time_us_32() of the scan that saw it
+    uint8_t button;
+    bool down;
+} ButtonEvent;
+
 
 void hw_init(void);
 
@@ -67,11 +74,15 @@ void hw_audio_start(void);
 // Read one of the rotary encoders. Absolute (cumulative) value, can be positive or negative.
 int32_t read_knob(int encoder);
 
-// Scan the input matrix
+// Scan the input matrix. Runs from a timer, every half millisecond.
 void hw_scan_matrix(void);
 
 bool hw_read_button(int button);
 
+// Take the oldest button change not yet taken, in the order they were scanned.
+// Returns false if there are none. Call from one place only.
+bool hw_get_button_event(ButtonEvent *evt);
+
 void hw_set_led(int led, uint8_t value);
 
 void hw_debug_led(bool value);
@@ -82,7 +93,7 @@ void delay_us_in_isr(uint32_t us);
 // Get audio buffer - blocks until one is available
 AudioBuffer get_audio_buffer(void);
 
-// Send out a previously got buffer
+// Send out a previously got buffer, of sample_count samples
 void put_audio_buffer(AudioBuffer buffer);
 
 // Allocate memory in external RAM
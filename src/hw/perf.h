@@ -15,6 +15,9 @@ typedef enum {
     PERF_SAMPLE_LOAD,
     PERF_CHAN_CORE0,
     PERF_CHAN_CORE1,
+    PERF_MIX,
+    PERF_AUDIO_OVERHEAD,
+    PERF_IDLE,              // percent of core 0 time left over, per second
     NUM_PERFCOUNTERS
 } PerfMetric;
 
@@ -29,6 +32,9 @@ int64_t perf_end(int metric);
 
 int64_t perf_get(int metric);
 
+// Record a value worked out from other metrics
+void perf_set(int metric, int64_t value);
+
 #ifdef __cplusplus
 }
 #endif
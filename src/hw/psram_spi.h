@@ -42,6 +42,8 @@ SOFTWARE.
  * Optional define:
  * - @c PSRAM_MUTEX - Define this to put PSRAM access behind a mutex. This must
  * be used if the PSRAM is to be used by multiple cores.
+ * - @c PSRAM_SPINLOCK - Define this to put PSRAM access behind a hardware
+ * spinlock instead. This is safe to use from interrupt handlers on both cores.
  *
  * Project homepage: https://github.com/polpo/rp2040-psram
  */
@@ -253,6 +255,27 @@ void psram_spi_uninit(psram_spi_inst_t spi);
 void psram_test(psram_spi_inst_t *psram);
 
 
+/******************************************************************************/
+// Locking for the direct access functions below. Interrupts must be off during a
+// transfer, and with PSRAM_SPINLOCK the other core is kept out as well.
+
+__force_inline static uint32_t psram_lock(void) {
+#if defined(PSRAM_SPINLOCK)
+    return spin_lock_blocking(psram.spinlock);
+#else
+    return save_and_disable_interrupts();
+#endif
+}
+
+__force_inline static void psram_unlock(uint32_t irq) {
+#if defined(PSRAM_SPINLOCK)
+    spin_unlock(psram.spinlock, irq);
+#else
+    restore_interrupts(irq);
+#endif
+}
+
+
 /******************************************************************************/
 // Write
 
@@ -262,7 +285,7 @@ __force_inline static void psram_write32(uint32_t addr, uint32_t val) {
     uint32_t cmd = 0x02000000 | addr;
     int sm = (addr >= PSRAM_DEVICE_SIZE) ? PSRAM_SM1 : PSRAM_SM0;
 
-    uint32_t irq = save_and_disable_interrupts();
+    uint32_t irq = psram_lock();
     pio_sm_put(PSRAM_PIO, sm, setup);
     pio_sm_put(PSRAM_PIO, sm, cmd);
     pio_sm_put(PSRAM_PIO, sm, __builtin_bswap32(val));
@@ -271,7 +294,7 @@ __force_inline static void psram_write32(uint32_t addr, uint32_t val) {
     if (timeout == 0) {
         printf("psram timeout! addr %08x\n", addr);
     }
-    restore_interrupts(irq);
+    psram_unlock(irq);
 };
 
 // Write bytes from a buffer
@@ -281,7 +304,7 @@ __force_inline static void psram_write(uint32_t addr, uint8_t *buffer, size_t by
     uint32_t cmd = 0x02000000 | addr;
     int sm = (addr >= PSRAM_DEVICE_SIZE) ? PSRAM_SM1 : PSRAM_SM0;
 
-    uint32_t irq = save_and_disable_interrupts();
+    uint32_t irq = psram_lock();
     pio_sm_put(PSRAM_PIO, sm, setup);
     pio_sm_put(PSRAM_PIO, sm, cmd);
     int num_bytes = bytes;
@@ -291,7 +314,7 @@ __force_inline static void psram_write(uint32_t addr, uint8_t *buffer, size_t by
         buffer += 4;
         while(!pio_sm_is_tx_fifo_empty(PSRAM_PIO, sm));
     }
-    restore_interrupts(irq);
+    psram_unlock(irq);
 }
 
 
@@ -305,11 +328,11 @@ __force_inline static uint32_t psram_read32(uint32_t addr) {
     uint32_t cmd = 0xeb000000 | addr;
     int sm = (addr >= PSRAM_DEVICE_SIZE) ? PSRAM_SM1 : PSRAM_SM0;
 
-    uint32_t irq = save_and_disable_interrupts();
+    uint32_t irq = psram_lock();
     pio_sm_put(PSRAM_PIO, sm, setup);
     pio_sm_put(PSRAM_PIO, sm, cmd);
     uint32_t val = pio_sm_get_blocking(PSRAM_PIO, sm);
-    restore_interrupts(irq);
+    psram_unlock(irq);
 
     return __builtin_bswap32(val);
 };
@@ -328,7 +351,7 @@ __force_inline static void psram_read(uint32_t addr, uint8_t *buffer, size_t byt
     uint32_t cmd = 0xeb000000 | addr;
     int sm = (addr >= PSRAM_DEVICE_SIZE) ? PSRAM_SM1 : PSRAM_SM0;
 
-    uint32_t irq = save_and_disable_interrupts();
+    uint32_t irq = psram_lock();
     pio_sm_put(PSRAM_PIO, sm, setup);
     pio_sm_put(PSRAM_PIO, sm, cmd);
     int num_bytes = bytes;
@@ -338,7 +361,7 @@ __force_inline static void psram_read(uint32_t addr, uint8_t *buffer, size_t byt
         buffer += 4;
         num_bytes -= 4;
     }
-    restore_interrupts(irq);
+    psram_unlock(irq);
 };
 
 
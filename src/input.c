@@ -8,7 +8,10 @@ RawInput input_read(void) {
         input.knob_raw[i] = read_knob(i);
     }
 
+    // On the device the matrix is scanned by a timer; the simulator has no timer
+#if !PICO_ON_DEVICE
     hw_scan_matrix();
+#endif
     for (int i=0; i<NUM_BUTTONS; i++) {
         input.button_raw[i] = hw_read_button(i);
     }
@@ -1,44 +1,86 @@
 #include <stdio.h>
 #include <cstdint>
+#include <math.h>
 #include "instrument.hpp"
 
-#define UPDATE_PARAM(par, delta) param[(par)] += delta; CLAMPPARAM(param[(par)]);
+// Change a parameter by the movement of one of the knobs
+#define CONTROL_PARAM(par, knob) if (in->knob_delta[(knob)]) set_param((par), param[(par)] + in->knob_delta[(knob)]);
 
 
 
+void Instrument::note_on(int note, bool accent_on, bool retrigger) {
+    midi_note = note;
+    note_freq = midi_note_to_freq(note);
+    accent = accent_on;
+    gate = 1;
+    if (retrigger) trigger = 1;
+}
+
+void Instrument::note_off(int note) {
+    if (note != midi_note) return;
+    gate = 0;
+    trigger = 0;
+}
+
+
 
 AcidBass::AcidBass() {
 }
 
 
-void AcidBass::init() {
+// Modulation matrix slots
+enum {
+    AB_MOD_ENV,             // envelope to cutoff
+    AB_MOD_ENV_ACCENT,      // and again on accented notes
+    AB_MOD_LFO
+};
 
-    param[AB_PARAM_FILTER] = 32;
-    param[AB_PARAM_RES] = 64;
-    param[AB_PARAM_ENVMOD] = 16;
-    param[AB_PARAM_ATTACK] = 4;
-    param[AB_PARAM_DECAY] = 32;
-    param[AB_PARAM_SUSTAIN] = 64;
-    param[AB_PARAM_RELEASE] = 64;
+void AcidBass::init() {
+    oversampler.init(AB_OVERSAMPLE);
+    oscillator_init(&osc);
+    mod.init();
+    mod.set_slot(AB_MOD_ENV,        MOD_SRC_ENV,  MOD_SRC_NONE,   MOD_DST_CUTOFF, 0.0f);
+    mod.set_slot(AB_MOD_ENV_ACCENT, MOD_SRC_ENV,  MOD_SRC_ACCENT, MOD_DST_CUTOFF, 0.0f);
+    mod.set_slot(AB_MOD_LFO,        MOD_SRC_LFO1, MOD_SRC_NONE,   MOD_DST_CUTOFF, 0.0f);
 
-    cutoff = param[AB_PARAM_FILTER];
-    resonance = param[AB_PARAM_RES];
-    env_mod = param[AB_PARAM_ENVMOD];
-    env.attack = map_attack(param[AB_PARAM_ATTACK]);
-    env.decay = map_decay(param[AB_PARAM_DECAY]);
-    env.sustain = map_sustain(param[AB_PARAM_SUSTAIN]);
-    env.release = map_decay(param[AB_PARAM_RELEASE]);
+    set_param(AB_PARAM_FILTER, 32);
+    set_param(AB_PARAM_RES, 64);
+    set_param(AB_PARAM_ENVMOD, 16);
+    set_param(AB_PARAM_ATTACK, 4);
+    set_param(AB_PARAM_DECAY, 32);
+    set_param(AB_PARAM_SUSTAIN, 64);
+    set_param(AB_PARAM_RELEASE, 64);
+    set_param(AB_PARAM_WAVE, 0);
+    set_param(AB_PARAM_LFO_RATE, 64);
+    set_param(AB_PARAM_LFO_DEPTH, 0);
+    cutoff_smooth = cutoff;
+    res_smooth = resonance;
 }
 
+void AcidBass::set_param(int par, int value) {
+    if (par < 0 || par >= AB_NUM_PARAMS) return;
+    CLAMPPARAM(value);
+    param[par] = value;
 
-float AcidBass::process() {
+    switch (par) {
+    case AB_PARAM_ATTACK:   env.attack = map_attack(value); break;
+    case AB_PARAM_DECAY:    env.decay = map_decay(value); break;
+    case AB_PARAM_SUSTAIN:  env.sustain = map_sustain(value); break;
+    case AB_PARAM_RELEASE:  env.release = map_decay(value); break;
+    case AB_PARAM_FILTER:   cutoff = value; break;
+    case AB_PARAM_RES:      resonance = value; break;
+    case AB_PARAM_ENVMOD:
+        mod.set_amount(AB_MOD_ENV, value);
+        mod.set_amount(AB_MOD_ENV_ACCENT, value);
+        break;
+    case AB_PARAM_WAVE:     osc.waveform = (OscWave)(value * NUM_WAVE / PARAM_SCALE); break;
+    case AB_PARAM_LFO_RATE: mod.lfo[0].rate = map_lfo_rate(value); break;
+    case AB_PARAM_LFO_DEPTH: mod.set_amount(AB_MOD_LFO, value / 2); break;
+    }
+}
 
-    // // LFO (testing)
-    // static Oscillator lfo;
-    // uint32_t lfo_freq = 1400000;
-    // lfo.phase += lfo_freq;
-    // int32_t lfo_wave = oscillator_saw(lfo.phase, lfo_freq, 0);
-    // // LFO goes from -ISCALE to +ISCALE    
+
+void AcidBass::process_block(sample_t *out, int n) {
 
     // Envelope retrigger
     if (gate && trigger) {
@@ -47,37 +89,75 @@ float AcidBass::process() {
     }
     bool envgate = gate; //|| note.glide; // ??
 
-    // Modulation (testing)
-    uint32_t freq = note_freq;
-    int newcutoff = cutoff;
-    int newresonance = resonance;
-    // const int depth_n = 3;  // scale numerator
-    // const int depth_b = 3;  // denominator bits
-    // int *dest = &gain;
-    // //*dest += (lfo_wave*depth_n) >> depth_b;
-    //CLAMP(gain, 0, ISCALE*2);
-    CLAMPPARAM(newcutoff);
-    CLAMPPARAM(newresonance);
-
-    // Oscillator
-    uint32_t dphase = freq;
-    osc.phase += dphase;
-    float s = oscillator_saw(osc.phase, dphase, 0);
-
-    // Envelope
-    float envelope = process_adsr(&env, envgate);
-
-    // Filter
-    int32_t mod = env_mod * envelope;
-    if (accent) mod = mod + mod;
-    filter.cutoff = svfreq_map(newcutoff + mod);
-    filter.res = (float)newresonance / PARAM_SCALE;
-    (void)process_svfilter(&filter, s); // oversample
-    s = process_svfilter(&filter, s);
+    for (int pos=0; pos<n; pos+=CONTROL_RATE_SAMPS) {
+        const int len = (n - pos < CONTROL_RATE_SAMPS) ? n - pos : CONTROL_RATE_SAMPS;
+
+        // Control rate: smooth the knobs, then the envelope and modulation
+        // give the values to ramp to by the end of this run
+        cutoff_smooth += (cutoff - cutoff_smooth) * CONTROL_SMOOTHING;
+        res_smooth += (resonance - res_smooth) * CONTROL_SMOOTHING;
+        float envelope = process_adsr_n(&env, envgate, len);
+
+        float dest[NUM_MOD_DESTS];
+        mod.process(len, envelope, accent, dest);
+
+        uint32_t dphase = note_freq;
+        if (dest[MOD_DST_PITCH] != 0.0f && midi_note >= 0) {
+            dphase = midi_cents_to_freq(100 * midi_note + lrintf(100.0f * dest[MOD_DST_PITCH]));
+        }
+        float newcutoff = cutoff_smooth + dest[MOD_DST_CUTOFF];
+        CLAMP(newcutoff, 0.0f, (float)PARAM_MAX);
+        const uint32_t cutoff_fine = newcutoff * SVFREQ_FINE_SCALE;
+        float newres = res_smooth + dest[MOD_DST_RES];
+        CLAMPPARAM(newres);
+        float amp_target = envelope * (1.0f + dest[MOD_DST_AMP]);
+        if (amp_target < 0.0f) amp_target = 0.0f;
+
+        // The resonant filter runs oversampled
+        const int os = oversampler.get_factor();
+        const int oslen = len * os;
+
+#ifdef AUDIO_Q15
+        // Oscillator
+        oscillator_block(&osc, &out[pos], dphase, len);
+        oversampler.up(&out[pos], os_buf, len);
+
+        // Filter: kq = 1 - 7/8 * res
+        const int32_t kq = 32768 - (int32_t)(28672 * newres) / PARAM_SCALE;
+        q15_ramp_block(cutoff_buf, &cutoff_ramp, svfreq_oversample_q15(svfreq_map_fine_q15(cutoff_fine), os), oslen);
+        q15_svfilter_block(&filter_q15, os_buf, cutoff_buf, kq, oslen);
+        oversampler.down(os_buf, &out[pos], len);
+
+        q15_ramp_block(&env_buf[pos], &amp_ramp, q15_from_float(amp_target), len);
+#else
+        oscillator_block(&osc, &osc_buf[pos], dphase, len);
+        for (int i=pos; i<pos+len; i++) {
+            out[i] = osc_buf[i] / 32768.0f;
+        }
+        oversampler.up(&out[pos], os_buf, len);
+
+        // Filter
+        filter.res = newres / PARAM_SCALE;
+        const float cutoff_step = (svfreq_oversample(svfreq_map_fine(cutoff_fine), os) - filter.cutoff) / oslen;
+        for (int i=0; i<oslen; i++) {
+            filter.cutoff += cutoff_step;
+            os_buf[i] = process_svfilter(&filter, os_buf[i]);
+        }
+        oversampler.down(os_buf, &out[pos], len);
 
+        // Amp
+        const float amp_step = (amp_target - amp) / len;
+        for (int i=pos; i<pos+len; i++) {
+            amp += amp_step;
+            out[i] *= amp;
+        }
+#endif
+    }
+
+#ifdef AUDIO_Q15
     // Amp
-    s *= envelope;
-    return s;
+    q15_mul_block(out, env_buf, n);
+#endif
 }
 
 
@@ -85,26 +165,22 @@ void AcidBass::control(InstrumentPage page, const InputState *in) {
 
     switch (page) {
     case INSTRUMENT_PAGE_OSC:
+        CONTROL_PARAM(AB_PARAM_WAVE, 0);
+        CONTROL_PARAM(AB_PARAM_LFO_RATE, 1);
+        CONTROL_PARAM(AB_PARAM_LFO_DEPTH, 2);
         break;
 
     case INSTRUMENT_PAGE_FILTER:
-        UPDATE_PARAM(AB_PARAM_FILTER, in->knob_delta[0]);
-        UPDATE_PARAM(AB_PARAM_RES,    in->knob_delta[1]);
-        UPDATE_PARAM(AB_PARAM_ENVMOD, in->knob_delta[2]);
-        if (in->knob_delta[0]) cutoff = param[AB_PARAM_FILTER];
-        if (in->knob_delta[1]) resonance = param[AB_PARAM_RES];
-        if (in->knob_delta[2]) env_mod = param[AB_PARAM_ENVMOD];
+        CONTROL_PARAM(AB_PARAM_FILTER, 0);
+        CONTROL_PARAM(AB_PARAM_RES,    1);
+        CONTROL_PARAM(AB_PARAM_ENVMOD, 2);
         break;
 
     case INSTRUMENT_PAGE_AMP:
-        UPDATE_PARAM(AB_PARAM_ATTACK,  in->knob_delta[0]);
-        UPDATE_PARAM(AB_PARAM_DECAY,   in->knob_delta[1]);
-        UPDATE_PARAM(AB_PARAM_SUSTAIN, in->knob_delta[2]);
-        UPDATE_PARAM(AB_PARAM_RELEASE, in->knob_delta[3]);
-        if (in->knob_delta[0]) env.attack = map_attack(param[AB_PARAM_ATTACK]);
-        if (in->knob_delta[1]) env.decay = map_decay(param[AB_PARAM_DECAY]);
-        if (in->knob_delta[2]) env.sustain = map_sustain(param[AB_PARAM_SUSTAIN]);
-        if (in->knob_delta[3]) env.release = map_decay(param[AB_PARAM_RELEASE]);
+        CONTROL_PARAM(AB_PARAM_ATTACK,  0);
+        CONTROL_PARAM(AB_PARAM_DECAY,   1);
+        CONTROL_PARAM(AB_PARAM_SUSTAIN, 2);
+        CONTROL_PARAM(AB_PARAM_RELEASE, 3);
         break;
     }
 }
@@ -125,7 +201,9 @@ void AcidBass::draw(InstrumentPage page) {
 }
 
 void AcidBass::draw_osc(void) {
-    ngl_text(FONT_A, 64,64, TEXT_CENTRE, "osc page");
+    draw_gauge_param(0, param[AB_PARAM_WAVE], osc_wave_names[osc.waveform]);
+    draw_gauge_param(1, param[AB_PARAM_LFO_RATE], "LFO rate");
+    draw_gauge_param(2, param[AB_PARAM_LFO_DEPTH], "LFO > cutoff");
 }
 
 void AcidBass::draw_filter(void) {
@@ -143,70 +221,467 @@ void AcidBass::draw_amp(void) {
 
 
 
-/****** test instrument ******/
+/****** drum synth ******/
 
 
-TestSynth::TestSynth() {}
+DrumSynth::DrumSynth() {}
 
 
-void TestSynth::init() {
+// Square wave frequencies of the hi-hat, from the TR-808
+static const float hat_freqs[6] = {205.3f, 304.4f, 369.6f, 522.7f, 540.0f, 800.0f};
 
-    param[PARAM_TEST_FILTER] = 32;
-    param[PARAM_TEST_RES] = 64;
+// Filter coefficient for a cutoff in Hz
+static float drum_kf(float freq) {
+    return 2.0f * sinf((float)M_PI * freq / SAMPLE_RATE);
+}
+
+void DrumSynth::init() {
+    for (int d=0; d<NUM_DRUMS; d++) {
+        DrumVoice *v = &voices[d];
+        v->env.attack = map_attack(0);
+        v->env.sustain = 0.0f;
+        v->env.release = map_decay(0);
+        v->active = false;
+        v->amp = 0.0f;
+        v->filter.res = 0.0f;
+    }
+    for (int h=0; h<6; h++) hat_freq[h] = hat_freqs[h] / SAMPLE_RATE * 4294967296.0f;
+    clap_kf = drum_kf(1200.0f);
+    voices[DRUM_CLAP].filter.res = 0.5f;
+    kick_sweep = 0.0f;
+    kick_sweep_decay = expf(-CONTROL_RATE_SAMPS / (0.03f * SAMPLE_RATE));
+    clap_bursts = 0;
 
-    cutoff = param[PARAM_TEST_FILTER];
-    resonance = param[PARAM_TEST_RES];
+    set_param(DR_PARAM_KICK_TUNE, 40);
+    set_param(DR_PARAM_KICK_PUNCH, 64);
+    set_param(DR_PARAM_KICK_DECAY, 56);
+    set_param(DR_PARAM_SNARE_TONE, 48);
+    set_param(DR_PARAM_SNARE_SNAP, 80);
+    set_param(DR_PARAM_SNARE_DECAY, 40);
+    set_param(DR_PARAM_HAT_TONE, 80);
+    set_param(DR_PARAM_HAT_DECAY, 24);
+    set_param(DR_PARAM_OPEN_HAT_DECAY, 64);
+    set_param(DR_PARAM_CLAP_DECAY, 48);
 }
 
+void DrumSynth::set_param(int par, int value) {
+    if (par < 0 || par >= DR_NUM_PARAMS) return;
+    CLAMPPARAM(value);
+    param[par] = value;
 
-float TestSynth::process() {
+    switch (par) {
+    case DR_PARAM_KICK_TUNE:        kick_base = (30.0f + value * 0.6f) / SAMPLE_RATE * 4294967296.0f; break;
+    case DR_PARAM_KICK_PUNCH:       kick_punch = value * 8.0f / PARAM_SCALE; break;
+    case DR_PARAM_KICK_DECAY:       voices[DRUM_KICK].env.decay = map_decay(value); break;
+    case DR_PARAM_SNARE_TONE: {
+        const float freq = 150.0f + value * 1.2f;
+        snare_freq[0] = freq / SAMPLE_RATE * 4294967296.0f;
+        snare_freq[1] = 1.7f * freq / SAMPLE_RATE * 4294967296.0f;
+        snare_kf = drum_kf(3000.0f + value * 50.0f);
+        break;
+    }
+    case DR_PARAM_SNARE_SNAP:       snare_snap = (float)value / PARAM_SCALE; break;
+    case DR_PARAM_SNARE_DECAY:      voices[DRUM_SNARE].env.decay = map_decay(value); break;
+    case DR_PARAM_HAT_TONE:         hat_kf = drum_kf(2000.0f + value * 80.0f); break;
+    case DR_PARAM_HAT_DECAY:        hat_decay = map_decay(value); break;
+    case DR_PARAM_OPEN_HAT_DECAY:   open_hat_decay = map_decay(value); break;
+    case DR_PARAM_CLAP_DECAY:       clap_decay = map_decay(value); break;
+    }
+}
 
-    return 0.0f;
+// General MIDI drum map, with any other note picking a drum by itself
+static int drum_for_note(int note, bool *open) {
+    *open = false;
+    switch (note) {
+    case 35: case 36:           return DRUM_KICK;
+    case 37: case 38: case 40:  return DRUM_SNARE;
+    case 39:                    return DRUM_CLAP;
+    case 42: case 44:           return DRUM_HAT;
+    case 46: *open = true;      return DRUM_HAT;
+    default:                    return note % NUM_DRUMS;
+    }
+}
 
-    /*int gain = ISCALE;
-    CLAMP(gain, 0, ISCALE*2);
+void DrumSynth::note_on(int note, bool accent_on, bool retrigger) {
+    Instrument::note_on(note, accent_on, retrigger);
 
-    // Oscillator
-    uint32_t dphase = note.freq;
-    osc.phase += dphase;
-    int32_t s1 = oscillator_saw(osc.phase, dphase, 0);
-    s1 = (s1 * gain) >> 15;
+    bool open;
+    const int drum = drum_for_note(note, &open);
+    DrumVoice *v = &voices[drum];
 
-    // Filter
-    //if (note.accent) mod = mod + mod;
-    filter.cutoff = svfreq_map(cutoff);
-    filter.res = resonance;
-    s1 = process_svfilter_int(&filter, s1);    
+    // Restart the envelope from its current level, so a retrigger doesn't click
+    v->env.state = ENV_ATTACK;
+    v->active = true;
+    v->gain = accent_on ? DRUM_ACCENT_GAIN : DRUM_GAIN;
 
-    // Amp
-    if (!gate) s1 = 0;
-    return s1;*/
+    switch (drum) {
+    case DRUM_KICK:
+        kick_sweep = 1.0f;
+        break;
+    case DRUM_HAT:
+        v->env.decay = open ? open_hat_decay : hat_decay;
+        break;
+    case DRUM_CLAP:
+        // Quick bursts first, then the tail
+        v->env.decay = map_decay(12);
+        clap_bursts = DRUM_CLAP_BURSTS - 1;
+        clap_timer = DRUM_CLAP_SPACING;
+        break;
+    }
 }
 
+void DrumSynth::silence() {
+    for (int d=0; d<NUM_DRUMS; d++) {
+        voices[d].active = false;
+        voices[d].amp = 0.0f;
+        voices[d].env.level = 0.0f;
+    }
+    clap_bursts = 0;
+    gate = 0;
+}
 
-void TestSynth::control(InstrumentPage page, const InputState *in) {
+bool DrumSynth::is_idle() {
+    for (int d=0; d<NUM_DRUMS; d++) {
+        if (voices[d].active) return false;
+    }
+    return true;
+}
+
+// Triangle shaped towards a sine
+static inline float drum_sine(uint32_t phase) {
+    const float t = 1.0f - 4.0f * fabsf(phase * (1.0f / 4294967296.0f) - 0.5f);
+    return t * (1.5f - 0.5f * t * t);
+}
+
+static inline float drum_tri(uint32_t phase) {
+    return 1.0f - 4.0f * fabsf(phase * (1.0f / 4294967296.0f) - 0.5f);
+}
+
+void DrumSynth::render_kick(DrumVoice *v, int pos, int len, float amp_step) {
+    // Pitch sweeps down to the base at control rate
+    const uint32_t dphase = kick_base * (1.0f + kick_punch * kick_sweep);
+    kick_sweep *= kick_sweep_decay;
+
+    for (int i=pos; i<pos+len; i++) {
+        v->phase[0] += dphase;
+        v->amp += amp_step;
+        buf[i] += drum_sine(v->phase[0]) * v->amp;
+    }
+}
+
+void DrumSynth::render_snare(DrumVoice *v, int pos, int len, float amp_step) {
+    // Two body tones and lowpassed noise
+    v->filter.cutoff = snare_kf;
+    const float body = 0.5f * (1.0f - snare_snap);
+    noise_white_block(noise, len);
+    for (int i=pos; i<pos+len; i++) {
+        v->phase[0] += snare_freq[0];
+        v->phase[1] += snare_freq[1];
+        const float tone = body * (drum_tri(v->phase[0]) + drum_tri(v->phase[1]));
+        const float snap = snare_snap * process_svfilter(&v->filter, noise[i-pos] * (1.0f / NOISE_PEAK));
+        v->amp += amp_step;
+        buf[i] += (tone + snap) * v->amp;
+    }
+}
+
+void DrumSynth::render_clap(DrumVoice *v, int pos, int len, float amp_step) {
+    // Bandpassed noise
+    v->filter.cutoff = clap_kf;
+    noise_white_block(noise, len);
+    for (int i=pos; i<pos+len; i++) {
+        process_svfilter(&v->filter, noise[i-pos] * (1.0f / NOISE_PEAK));
+        v->amp += amp_step;
+        buf[i] += 2.0f * v->filter.bp * v->amp;
+    }
+}
+
+void DrumSynth::render_hat(DrumVoice *v, int pos, int len, float amp_step) {
+    // Six squares at inharmonic ratios plus noise, highpassed
+    v->filter.cutoff = hat_kf;
+    noise_white_block(noise, len);
+    for (int i=pos; i<pos+len; i++) {
+        int squares = 0;
+        for (int h=0; h<6; h++) {
+            v->phase[h] += hat_freq[h];
+            squares += (int32_t)v->phase[h] >> 31;
+        }
+        const float x = (2 * squares + 6) * (1.0f / 12.0f) + noise[i-pos] * (0.5f / NOISE_PEAK);
+        const float hp = x - process_svfilter(&v->filter, x);
+        v->amp += amp_step;
+        buf[i] += hp * v->amp;
+    }
+}
+
+void DrumSynth::process_block(sample_t *out, int n) {
+    memset(buf, 0, n * sizeof(float));
+
+    for (int pos=0; pos<n; pos+=CONTROL_RATE_SAMPS) {
+        const int len = (n - pos < CONTROL_RATE_SAMPS) ? n - pos : CONTROL_RATE_SAMPS;
+
+        // Clap bursts restart the envelope, the last one with the tail's decay
+        if (clap_bursts > 0) {
+            clap_timer -= len;
+            if (clap_timer <= 0) {
+                DrumVoice *v = &voices[DRUM_CLAP];
+                clap_timer += DRUM_CLAP_SPACING;
+                clap_bursts--;
+                v->env.state = ENV_ATTACK;
+                if (clap_bursts == 0) v->env.decay = clap_decay;
+            }
+        }
+
+        for (int d=0; d<NUM_DRUMS; d++) {
+            DrumVoice *v = &voices[d];
+            if (!v->active) continue;
+
+            const float target = process_adsr_n(&v->env, true, len) * v->gain;
+            const float amp_step = (target - v->amp) / len;
+            switch (d) {
+            case DRUM_KICK:     render_kick(v, pos, len, amp_step); break;
+            case DRUM_SNARE:    render_snare(v, pos, len, amp_step); break;
+            case DRUM_CLAP:     render_clap(v, pos, len, amp_step); break;
+            case DRUM_HAT:      render_hat(v, pos, len, amp_step); break;
+            }
+
+            // Finished once the envelope has decayed to nothing
+            if (v->env.state == ENV_SUSTAIN && !(d == DRUM_CLAP && clap_bursts > 0)) {
+                v->active = false;
+                v->amp = 0.0f;
+            }
+        }
+    }
+
+    for (int i=0; i<n; i++) {
+        out[i] = to_sample(buf[i]);
+    }
+}
+
+
+void DrumSynth::control(InstrumentPage page, const InputState *in) {
 
     switch (page) {
     case INSTRUMENT_PAGE_OSC:
+        CONTROL_PARAM(DR_PARAM_KICK_TUNE,  0);
+        CONTROL_PARAM(DR_PARAM_KICK_PUNCH, 1);
+        CONTROL_PARAM(DR_PARAM_KICK_DECAY, 2);
         break;
 
     case INSTRUMENT_PAGE_FILTER:
-        UPDATE_PARAM(PARAM_TEST_FILTER, in->knob_delta[0]);
-        UPDATE_PARAM(PARAM_TEST_RES, in->knob_delta[1]);
-        if (in->knob_delta[0]) cutoff = param[PARAM_TEST_FILTER];
-        if (in->knob_delta[1]) resonance = param[PARAM_TEST_RES];
+        CONTROL_PARAM(DR_PARAM_SNARE_TONE,  0);
+        CONTROL_PARAM(DR_PARAM_SNARE_SNAP,  1);
+        CONTROL_PARAM(DR_PARAM_SNARE_DECAY, 2);
         break;
 
     case INSTRUMENT_PAGE_AMP:
+        CONTROL_PARAM(DR_PARAM_HAT_TONE,       0);
+        CONTROL_PARAM(DR_PARAM_HAT_DECAY,      1);
+        CONTROL_PARAM(DR_PARAM_OPEN_HAT_DECAY, 2);
+        CONTROL_PARAM(DR_PARAM_CLAP_DECAY,     3);
         break;
     }
 }
 
-void TestSynth::draw(InstrumentPage page) {
+void DrumSynth::draw(InstrumentPage page) {
+
+    switch (page) {
+    case INSTRUMENT_PAGE_OSC:
+        draw_kick();
+        break;
+    case INSTRUMENT_PAGE_FILTER:
+        draw_snare();
+        break;
+    case INSTRUMENT_PAGE_AMP:
+        draw_hats();
+        break;
+    }
+}
+
+void DrumSynth::draw_kick(void) {
+    draw_gauge_param(0, param[DR_PARAM_KICK_TUNE], "Kick tune");
+    draw_gauge_param(1, param[DR_PARAM_KICK_PUNCH], "Punch");
+    draw_gauge_param(2, param[DR_PARAM_KICK_DECAY], "Kick decay");
+}
+
+void DrumSynth::draw_snare(void) {
+    draw_gauge_param(0, param[DR_PARAM_SNARE_TONE], "Snare tone");
+    draw_gauge_param(1, param[DR_PARAM_SNARE_SNAP], "Snap");
+    draw_gauge_param(2, param[DR_PARAM_SNARE_DECAY], "Snare decay");
+}
+
+void DrumSynth::draw_hats(void) {
+    draw_gauge_param(0, param[DR_PARAM_HAT_TONE], "Hat tone");
+    draw_gauge_param(1, param[DR_PARAM_HAT_DECAY], "Closed");
+    draw_gauge_param(2, param[DR_PARAM_OPEN_HAT_DECAY], "Open");
+    draw_gauge_param(3, param[DR_PARAM_CLAP_DECAY], "Clap decay");
+}
+
+
+
+/****** polyphonic synth ******/
+
+
+PolySynth::PolySynth() {}
+
+
+void PolySynth::init() {
+    oversampler.init(PS_OVERSAMPLE);
+    voices.init();
+    set_param(PS_PARAM_FILTER, 80);
+    set_param(PS_PARAM_RES, 32);
+    set_param(PS_PARAM_ATTACK, 8);
+    set_param(PS_PARAM_DECAY, 48);
+    set_param(PS_PARAM_SUSTAIN, 96);
+    set_param(PS_PARAM_RELEASE, 72);
+    cutoff_smooth = cutoff;
+    res_smooth = resonance;
+}
+
+void PolySynth::set_param(int par, int value) {
+    if (par < 0 || par >= PS_NUM_PARAMS) return;
+    CLAMPPARAM(value);
+    param[par] = value;
+
+    for (int v=0; v<POLY_VOICES; v++) {
+        ADSR *env = &voices.voices[v].env;
+        switch (par) {
+        case PS_PARAM_ATTACK:   env->attack = map_attack(value); break;
+        case PS_PARAM_DECAY:    env->decay = map_decay(value); break;
+        case PS_PARAM_SUSTAIN:  env->sustain = map_sustain(value); break;
+        case PS_PARAM_RELEASE:  env->release = map_decay(value); break;
+        }
+    }
+
+    switch (par) {
+    case PS_PARAM_FILTER:   cutoff = value; break;
+    case PS_PARAM_RES:      resonance = value; break;
+    }
+}
+
+void PolySynth::note_on(int note, bool accent_on, bool retrigger) {
+    PolyVoice *voice = voices.note_on(note);
+    voice->freq = midi_note_to_freq(note);
+    voice->gate = true;
+    // Restart the envelope from its current level, so a stolen voice doesn't click
+    voice->env.state = ENV_ATTACK;
+
+    midi_note = note;
+    note_freq = voice->freq;
+    accent = accent_on;
+    gate = 1;
+}
+
+void PolySynth::note_off(int note) {
+    voices.note_off(note);
+
+    gate = 0;
+    for (int v=0; v<POLY_VOICES; v++) {
+        if (voices.is_active(v) && voices.voices[v].gate) gate = 1;
+    }
+}
+
+void PolySynth::silence() {
+    voices.release_all();
+    gate = 0;
+}
+
+
+void PolySynth::process_block(sample_t *out, int n) {
+#ifdef AUDIO_Q15
+    const int16_t voice_gain = POLY_VOICE_GAIN * (1 << Q15_MIX_GAIN_BITS);
+    memset(mix_buf, 0, n * sizeof(int32_t));
+
+    for (int v=0; v<POLY_VOICES; v++) {
+        if (!voices.is_active(v)) continue;
+        PolyVoice *voice = &voices.voices[v];
+
+        wavetable_block(voice_buf, WT_SAW, &voice->phase, voice->freq, n);
+        for (int pos=0; pos<n; pos+=CONTROL_RATE_SAMPS) {
+            const int len = (n - pos < CONTROL_RATE_SAMPS) ? n - pos : CONTROL_RATE_SAMPS;
+            float envelope = process_adsr_n(&voice->env, voice->gate, len);
+            q15_ramp_block(&env_buf[pos], &voice->amp_ramp, q15_from_float(envelope), len);
+        }
+        q15_mul_block(voice_buf, env_buf, n);
+        q15_mix_block(mix_buf, voice_buf, voice_gain, n);
+    }
+
+    for (int i=0; i<n; i++) {
+        out[i] = q15_sat(mix_buf[i] >> Q15_MIX_GAIN_BITS);
+    }
+#else
+    memset(out, 0, n * sizeof(sample_t));
+
+    for (int v=0; v<POLY_VOICES; v++) {
+        if (!voices.is_active(v)) continue;
+        PolyVoice *voice = &voices.voices[v];
+
+        wavetable_block(osc_buf, WT_SAW, &voice->phase, voice->freq, n);
+        for (int pos=0; pos<n; pos+=CONTROL_RATE_SAMPS) {
+            const int len = (n - pos < CONTROL_RATE_SAMPS) ? n - pos : CONTROL_RATE_SAMPS;
+            float envelope = process_adsr_n(&voice->env, voice->gate, len);
+            const float amp_step = (envelope - voice->amp) / len;
+            for (int i=pos; i<pos+len; i++) {
+                voice->amp += amp_step;
+                out[i] += osc_buf[i] / 32768.0f * voice->amp * POLY_VOICE_GAIN;
+            }
+        }
+    }
+#endif
+
+    // Filter, with the coefficients updated at control rate
+    for (int pos=0; pos<n; pos+=CONTROL_RATE_SAMPS) {
+        const int len = (n - pos < CONTROL_RATE_SAMPS) ? n - pos : CONTROL_RATE_SAMPS;
+        cutoff_smooth += (cutoff - cutoff_smooth) * CONTROL_SMOOTHING;
+        res_smooth += (resonance - res_smooth) * CONTROL_SMOOTHING;
+
+        const int os = oversampler.get_factor();
+        const int oslen = len * os;
+        oversampler.up(&out[pos], os_buf, len);
+
+#ifdef AUDIO_Q15
+        const int32_t kq = 32768 - (int32_t)(28672 * res_smooth) / PARAM_SCALE;
+        q15_ramp_block(cutoff_buf, &cutoff_ramp, svfreq_oversample_q15(svfreq_map_fine_q15(cutoff_smooth * SVFREQ_FINE_SCALE), os), oslen);
+        q15_svfilter_block(&filter_q15, os_buf, cutoff_buf, kq, oslen);
+#else
+        filter.res = res_smooth / PARAM_SCALE;
+        const float cutoff_step = (svfreq_oversample(svfreq_map_fine(cutoff_smooth * SVFREQ_FINE_SCALE), os) - filter.cutoff) / oslen;
+        for (int i=0; i<oslen; i++) {
+            filter.cutoff += cutoff_step;
+            os_buf[i] = process_svfilter(&filter, os_buf[i]);
+        }
+#endif
+
+        oversampler.down(os_buf, &out[pos], len);
+    }
+
+    voices.update();
+}
+
+
+void PolySynth::control(InstrumentPage page, const InputState *in) {
 
     switch (page) {
     case INSTRUMENT_PAGE_OSC:
-        draw_osc();
+        break;
+
+    case INSTRUMENT_PAGE_FILTER:
+        CONTROL_PARAM(PS_PARAM_FILTER, 0);
+        CONTROL_PARAM(PS_PARAM_RES,    1);
+        break;
+
+    case INSTRUMENT_PAGE_AMP:
+        CONTROL_PARAM(PS_PARAM_ATTACK,  0);
+        CONTROL_PARAM(PS_PARAM_DECAY,   1);
+        CONTROL_PARAM(PS_PARAM_SUSTAIN, 2);
+        CONTROL_PARAM(PS_PARAM_RELEASE, 3);
+        break;
+    }
+}
+
+void PolySynth::draw(InstrumentPage page) {
+
+    switch (page) {
+    case INSTRUMENT_PAGE_OSC:
+        ngl_text(FONT_A, 64,64, TEXT_CENTRE, "osc page");
         break;
     case INSTRUMENT_PAGE_FILTER:
         draw_filter();
@@ -217,14 +692,501 @@ void TestSynth::draw(InstrumentPage page) {
     }
 }
 
-void TestSynth::draw_osc(void) {
-    ngl_text(FONT_A, 64,64, TEXT_CENTRE, "osc page");
+void PolySynth::draw_filter(void) {
+    draw_gauge_param(0, param[PS_PARAM_FILTER], "Cutoff");
+    draw_gauge_param(1, param[PS_PARAM_RES], "Res.");
+}
+
+void PolySynth::draw_amp(void) {
+    draw_gauge_param(0, param[PS_PARAM_ATTACK], "Attack");
+    draw_gauge_param(1, param[PS_PARAM_DECAY], "Decay");
+    draw_gauge_param(2, param[PS_PARAM_SUSTAIN], "Sustain");
+    draw_gauge_param(3, param[PS_PARAM_RELEASE], "Release");
+}
+
+
+
+/****** granular sample player ******/
+
+
+Granular::Granular() {}
+
+
+void Granular::init() {
+    for (int g=0; g<GRANULAR_MAX_GRAINS; g++) grains[g].active = false;
+    env.sustain = 1.0f;
+    env.decay = 0.0f;
+    set_param(GR_PARAM_SAMPLE, 0);
+    set_param(GR_PARAM_POSITION, 0);
+    set_param(GR_PARAM_SPEED, 64);
+    set_param(GR_PARAM_SPRAY, 8);
+    set_param(GR_PARAM_SIZE, 48);
+    set_param(GR_PARAM_DENSITY, 64);
+    set_param(GR_PARAM_ATTACK, 16);
+    set_param(GR_PARAM_RELEASE, 48);
+    set_param(GR_PARAM_GRAINS, 64);
+}
+
+void Granular::set_param(int par, int value) {
+    if (par < 0 || par >= GR_NUM_PARAMS) return;
+    CLAMPPARAM(value);
+    param[par] = value;
+
+    switch (par) {
+    case GR_PARAM_SAMPLE: {
+        // Index into the sample list
+        const int nsamps = SampleManager::sample_list.size();
+        if (value >= nsamps) value = nsamps - 1;
+        param[par] = (value < 0) ? 0 : value;
+        const int id = (value < 0) ? -1 : SampleManager::sample_list[value].sample_id;
+        // This can be called from the audio callback, so leave loading the sample to
+        // background() and keep playing the old one until it's there
+        SampleInfo *samp = (id >= 0) ? SampleManager::get_info(id) : NULL;
+        if (samp && !samp->is_loaded) {
+            load_id = id;
+        } else {
+            sample_id = id;
+            load_id = -1;
+        }
+        break;
+    }
+    case GR_PARAM_POSITION: seek = true; break;
+    case GR_PARAM_SPEED:    speed = (value << 17) / PARAM_SCALE; break;     // 1x in the middle
+    case GR_PARAM_SPRAY:    spray = value * value * (SAMPLE_RATE / 2) / (PARAM_SCALE * PARAM_SCALE); break;
+    case GR_PARAM_SIZE:     grain_size = SAMPLE_RATE / 200 + value * value * 3 / 2; break;
+    case GR_PARAM_DENSITY:  density = 1.0f + value * value / 64.0f; break;
+    case GR_PARAM_ATTACK:   env.attack = map_attack(value); break;
+    case GR_PARAM_RELEASE:  env.release = map_decay(value); break;
+    case GR_PARAM_GRAINS:   grain_budget = 1 + value * (GRANULAR_MAX_GRAINS - 1) / PARAM_MAX; break;
+    }
+
+    if (par == GR_PARAM_SIZE || par == GR_PARAM_DENSITY || par == GR_PARAM_GRAINS) update_gain();
+}
+
+void Granular::update_gain() {
+    // Grains overlapping at random add up in power, so scale by 1/sqrt(overlap)
+    float overlap = density * grain_size / SAMPLE_RATE;
+    if (overlap > grain_budget) overlap = grain_budget;
+    if (overlap < 1.0f) overlap = 1.0f;
+    grain_gain = 32767 / sqrtf(overlap);
+}
+
+void Granular::note_on(int note, bool accent_on, bool retrigger) {
+    Instrument::note_on(note, accent_on, retrigger);
+    env.state = ENV_ATTACK;
+    // Each note starts from the position set, with a grain straight away
+    seek = true;
+    next_grain = 1.0f;
+}
+
+void Granular::start_grain(int offset, const SampleInfo *samp) {
+    Grain *g = NULL;
+    int active = 0;
+    for (int i=0; i<GRANULAR_MAX_GRAINS; i++) {
+        if (grains[i].active) active++;
+        else if (!g) g = &grains[i];
+    }
+    if (!g || active >= grain_budget) return;
+
+    const int32_t length = samp->length;
+    int32_t start = playhead >> 32;
+    if (spray > 0) start += (int32_t)(noise_rand() % (2 * spray + 1)) - spray;
+    start %= length;
+    if (start < 0) start += length;
+
+    const uint32_t root_freq = midi_note_to_freq(samp->root_midi_note);
+    uint64_t inc = root_freq ? ((uint64_t)note_freq << 32) / root_freq : (1ULL << 32);
+    if (inc > ((uint64_t)GRANULAR_MAX_RATIO << 32)) inc = (uint64_t)GRANULAR_MAX_RATIO << 32;
+
+    g->active = true;
+    g->offset = offset;
+    g->remaining = grain_size;
+    g->start = start;
+    g->phase = 0;
+    g->inc = inc;
+    g->win_phase = 0;
+    g->win_inc = 0xFFFFFFFFu / grain_size;
+}
+
+void Granular::render_grain(Grain *g, int id, int n) {
+    const int len = (n - g->offset < g->remaining) ? n - g->offset : g->remaining;
+
+    // All the frames for this buffer in one read
+    const uint32_t base = g->phase >> 32;
+    const int frames = ((g->phase + (uint64_t)(len - 1) * g->inc) >> 32) - base + 2;
+    SampleManager::fetch_block(id, g->start + base, fetch_buf, frames);
+
+    int32_t *mix = &mix_buf[g->offset];
+    for (int i=0; i<len; i++) {
+        const int16_t *x = &fetch_buf[(uint32_t)(g->phase >> 32) - base];
+        const int32_t frac = (uint32_t)g->phase >> 17;
+        const int32_t s = x[0] + q15_mul32(x[1] - x[0], frac);
+
+        const int wi = g->win_phase >> (32 - GRAIN_WINDOW_BITS);
+        const int32_t wfrac = (g->win_phase >> (32 - GRAIN_WINDOW_BITS - 15)) & 0x7FFF;
+        const int32_t w = grain_window_table[wi] + q15_mul32(grain_window_table[wi+1] - grain_window_table[wi], wfrac);
+
+        mix[i] += (s * w) >> 15;
+        g->phase += g->inc;
+        g->win_phase += g->win_inc;
+    }
+
+    g->offset = 0;
+    g->remaining -= len;
+    if (g->remaining <= 0) g->active = false;
+}
+
+void Granular::process_block(sample_t *out, int n) {
+    memset(mix_buf, 0, n * sizeof(int32_t));
+
+    // Switch to a new sample once it has been loaded
+    const int pending = load_id;
+    if (pending >= 0) {
+        SampleInfo *next = SampleManager::get_info(pending);
+        if (!next || next->is_loaded) {
+            sample_id = next ? pending : -1;
+            load_id = -1;
+        }
+    }
+    const int id = sample_id;
+    SampleInfo *samp = (id >= 0) ? SampleManager::get_info(id) : NULL;
+    const int32_t length = (samp && samp->is_loaded) ? samp->length : 0;
+    const uint64_t end = (uint64_t)length << 32;
+    if (seek) {
+        seek = false;
+        playhead = (uint64_t)param[GR_PARAM_POSITION] * end / PARAM_SCALE;
+    }
+
+    for (int pos=0; pos<n; pos+=CONTROL_RATE_SAMPS) {
+        const int len = (n - pos < CONTROL_RATE_SAMPS) ? n - pos : CONTROL_RATE_SAMPS;
+        float envelope = process_adsr_n(&env, gate, len);
+        q15_ramp_block(&env_buf[pos], &amp_ramp, q15_from_float(envelope), len);
+
+        // Start grains and move the playhead on while the note sounds
+        if (length > 0 && envelope > 0.0f) {
+            next_grain += density * len / SAMPLE_RATE;
+            while (next_grain >= 1.0f) {
+                next_grain -= 1.0f;
+                start_grain(pos, samp);
+            }
+            playhead += ((uint64_t)speed * len) << 16;
+            if (playhead >= end) playhead %= end;
+        }
+    }
+
+    for (int g=0; g<GRANULAR_MAX_GRAINS; g++) {
+        if (!grains[g].active) continue;
+        if (length > 0) render_grain(&grains[g], id, n);
+        else grains[g].active = false;
+    }
+
+    for (int i=0; i<n; i++) {
+        const int32_t y = q15_mul32(q15_mul32(mix_buf[i], grain_gain), env_buf[i]);
+        out[i] = int16_to_sample(q15_sat(y));
+    }
+}
+
+
+// Load the sample asked for by set_param(). process_block() switches to it when
+// it's ready. If loading fails it stays on the old one.
+void Granular::background() {
+    const int id = load_id;
+    if (id < 0) return;
+    SampleInfo *samp = SampleManager::get_info(id);
+    if (samp && !samp->is_loaded && SampleManager::load(id) < 0 && load_id == id) {
+        load_id = -1;
+    }
+}
+
+
+void Granular::control(InstrumentPage page, const InputState *in) {
+
+    switch (page) {
+    case INSTRUMENT_PAGE_OSC:
+        CONTROL_PARAM(GR_PARAM_POSITION, 0);
+        CONTROL_PARAM(GR_PARAM_SPEED,    1);
+        CONTROL_PARAM(GR_PARAM_SIZE,     2);
+        CONTROL_PARAM(GR_PARAM_DENSITY,  3);
+        break;
+
+    case INSTRUMENT_PAGE_FILTER:
+        if (in->knob_delta[0]) {
+            set_param(GR_PARAM_SAMPLE, param[GR_PARAM_SAMPLE] + in->knob_delta[0]);
+        }
+        CONTROL_PARAM(GR_PARAM_SPRAY, 1);
+        break;
+
+    case INSTRUMENT_PAGE_AMP:
+        CONTROL_PARAM(GR_PARAM_ATTACK,  0);
+        CONTROL_PARAM(GR_PARAM_RELEASE, 1);
+        CONTROL_PARAM(GR_PARAM_GRAINS,  2);
+        break;
+    }
+}
+
+void Granular::draw(InstrumentPage page) {
+
+    switch (page) {
+    case INSTRUMENT_PAGE_OSC:
+        draw_grain();
+        break;
+    case INSTRUMENT_PAGE_FILTER:
+        draw_sample();
+        break;
+    case INSTRUMENT_PAGE_AMP:
+        draw_amp();
+        break;
+    }
+}
+
+void Granular::draw_grain(void) {
+    draw_gauge_param(0, param[GR_PARAM_POSITION], "Position");
+    draw_gauge_param(1, param[GR_PARAM_SPEED], "Speed");
+    draw_gauge_param(2, param[GR_PARAM_SIZE], "Size");
+    draw_gauge_param(3, param[GR_PARAM_DENSITY], "Density");
+}
+
+void Granular::draw_sample(void) {
+    // Show the sample chosen, even while it's still loading
+    const int id = (load_id >= 0) ? load_id : sample_id;
+    SampleInfo *samp = (id >= 0) ? SampleManager::get_info(id) : NULL;
+    draw_gauge_param(0, param[GR_PARAM_SAMPLE], samp ? samp->name : "No sample");
+    draw_gauge_param(1, param[GR_PARAM_SPRAY], "Spray");
+}
+
+void Granular::draw_amp(void) {
+    draw_gauge_param(0, param[GR_PARAM_ATTACK], "Attack");
+    draw_gauge_param(1, param[GR_PARAM_RELEASE], "Release");
+    char grains[16];
+    snprintf(grains, sizeof(grains), "%d grains", grain_budget);
+    draw_gauge_param(2, param[GR_PARAM_GRAINS], grains);
+}
+
+
+
+/****** FM synth ******/
+
+
+FMSynth::FMSynth() {}
+
+
+// Operator each one modulates, or FM_CARRIER for those heard in the output.
+// Modulators always have a higher number than the operator they modulate, so the
+// operators are rendered from the top down.
+#define FM_CARRIER -1
+
+struct FMAlgorithm {
+    int num_ops;
+    int8_t target[FM_MAX_OPS];
+    const char *name;
+};
+
+static const FMAlgorithm fm_algorithms[FM_NUM_ALGORITHMS] = {
+    {2, {FM_CARRIER, 0, 0, 0},          "2>1"},
+    {3, {FM_CARRIER, 0, 1, 0},          "3>2>1"},
+    {4, {FM_CARRIER, 0, 1, 2},          "4>3>2>1"},
+    {4, {FM_CARRIER, 0, FM_CARRIER, 2}, "2>1 4>3"},
+    {4, {FM_CARRIER, 0, 0, 0},          "2+3+4>1"},
+};
+
+// Frequency ratios, with 1 fractional bit
+static const uint8_t fm_ratios[16] = {1, 2, 3, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 28, 32};
+
+// All the operators' envelopes have the same settings and start together, and
+// operator 1 always plays, so its envelope says when the voice has finished
+bool FMVoice::is_idle() {
+    return !gate && env[0].level <= 0.0f;
+}
+
+void FMSynth::init() {
+    voices.init();
+    ratio[0] = 2;
+    level[0] = 1.0f;
+    set_param(FM_PARAM_ALGORITHM, 0);
+    set_param(FM_PARAM_RATIO_2, 24);
+    set_param(FM_PARAM_RATIO_3, 8);
+    set_param(FM_PARAM_RATIO_4, 40);
+    set_param(FM_PARAM_LEVEL_2, 48);
+    set_param(FM_PARAM_LEVEL_3, 32);
+    set_param(FM_PARAM_LEVEL_4, 16);
+    set_param(FM_PARAM_FEEDBACK, 0);
+    set_param(FM_PARAM_ATTACK, 2);
+    set_param(FM_PARAM_DECAY, 48);
+    set_param(FM_PARAM_SUSTAIN, 64);
+    set_param(FM_PARAM_RELEASE, 56);
+}
+
+void FMSynth::set_param(int par, int value) {
+    if (par < 0 || par >= FM_NUM_PARAMS) return;
+    CLAMPPARAM(value);
+    param[par] = value;
+
+    for (int v=0; v<FM_VOICES; v++) {
+        for (int op=0; op<FM_MAX_OPS; op++) {
+            ADSR *env = &voices.voices[v].env[op];
+            switch (par) {
+            case FM_PARAM_ATTACK:   env->attack = map_attack(value); break;
+            case FM_PARAM_DECAY:    env->decay = map_decay(value); break;
+            case FM_PARAM_SUSTAIN:  env->sustain = map_sustain(value); break;
+            case FM_PARAM_RELEASE:  env->release = map_decay(value); break;
+            }
+        }
+    }
+
+    switch (par) {
+    case FM_PARAM_ALGORITHM:    algorithm = value * FM_NUM_ALGORITHMS / PARAM_SCALE; break;
+    case FM_PARAM_RATIO_2:      ratio[1] = fm_ratios[value * 16 / PARAM_SCALE]; break;
+    case FM_PARAM_RATIO_3:      ratio[2] = fm_ratios[value * 16 / PARAM_SCALE]; break;
+    case FM_PARAM_RATIO_4:      ratio[3] = fm_ratios[value * 16 / PARAM_SCALE]; break;
+    case FM_PARAM_LEVEL_2:      level[1] = map_sustain(value); break;
+    case FM_PARAM_LEVEL_3:      level[2] = map_sustain(value); break;
+    case FM_PARAM_LEVEL_4:      level[3] = map_sustain(value); break;
+    case FM_PARAM_FEEDBACK:     feedback = value * 128; break;
+    }
+}
+
+void FMSynth::note_on(int note, bool accent_on, bool retrigger) {
+    FMVoice *voice = voices.note_on(note);
+    voice->freq = midi_note_to_freq(note);
+    voice->gate = true;
+    // Restart the envelopes from their current levels, so a stolen voice doesn't click
+    for (int op=0; op<FM_MAX_OPS; op++) voice->env[op].state = ENV_ATTACK;
+
+    midi_note = note;
+    note_freq = voice->freq;
+    accent = accent_on;
+    gate = 1;
+}
+
+void FMSynth::note_off(int note) {
+    voices.note_off(note);
+
+    gate = 0;
+    for (int v=0; v<FM_VOICES; v++) {
+        if (voices.is_active(v) && voices.voices[v].gate) gate = 1;
+    }
+}
+
+void FMSynth::silence() {
+    voices.release_all();
+    gate = 0;
+}
+
+void FMSynth::render_voice(FMVoice *voice, int n) {
+    const FMAlgorithm *alg = &fm_algorithms[algorithm];
+    const int16_t voice_gain = FM_VOICE_GAIN * (1 << Q15_MIX_GAIN_BITS);
+    const int top = alg->num_ops - 1;
+
+    for (int op=0; op<alg->num_ops; op++) memset(mod_buf[op], 0, n * sizeof(uint32_t));
+
+    for (int op=top; op>=0; op--) {
+        const uint32_t dphase = ((uint64_t)voice->freq * ratio[op]) >> 1;
+        q15_fm_op_block(op_buf, mod_buf[op], &voice->phase[op], dphase,
+                        (op == top) ? feedback : 0, voice->fb_state, n);
+
+        // Envelope times level, ramped at control rate
+        for (int pos=0; pos<n; pos+=CONTROL_RATE_SAMPS) {
+            const int len = (n - pos < CONTROL_RATE_SAMPS) ? n - pos : CONTROL_RATE_SAMPS;
+            const float envelope = process_adsr_n(&voice->env[op], voice->gate, len);
+            q15_ramp_block(&env_buf[pos], &voice->amp_ramp[op], q15_from_float(envelope * level[op]), len);
+        }
+        q15_mul_block(op_buf, env_buf, n);
+
+        const int target = alg->target[op];
+        if (target == FM_CARRIER) {
+            q15_mix_block(mix_buf, op_buf, voice_gain, n);
+        } else {
+            uint32_t *mod = mod_buf[target];
+            for (int i=0; i<n; i++) {
+                mod[i] += (uint32_t)(int32_t)op_buf[i] << FM_MOD_SHIFT;
+            }
+        }
+    }
+}
+
+void FMSynth::process_block(sample_t *out, int n) {
+    memset(mix_buf, 0, n * sizeof(int32_t));
+
+    for (int v=0; v<FM_VOICES; v++) {
+        if (voices.is_active(v)) render_voice(&voices.voices[v], n);
+    }
+
+    for (int i=0; i<n; i++) {
+        out[i] = int16_to_sample(q15_sat(mix_buf[i] >> Q15_MIX_GAIN_BITS));
+    }
+
+    voices.update();
+}
+
+
+void FMSynth::control(InstrumentPage page, const InputState *in) {
+
+    switch (page) {
+    case INSTRUMENT_PAGE_OSC:
+        CONTROL_PARAM(FM_PARAM_ALGORITHM, 0);
+        CONTROL_PARAM(FM_PARAM_RATIO_2,   1);
+        CONTROL_PARAM(FM_PARAM_RATIO_3,   2);
+        CONTROL_PARAM(FM_PARAM_RATIO_4,   3);
+        break;
+
+    case INSTRUMENT_PAGE_FILTER:
+        CONTROL_PARAM(FM_PARAM_LEVEL_2,  0);
+        CONTROL_PARAM(FM_PARAM_LEVEL_3,  1);
+        CONTROL_PARAM(FM_PARAM_LEVEL_4,  2);
+        CONTROL_PARAM(FM_PARAM_FEEDBACK, 3);
+        break;
+
+    case INSTRUMENT_PAGE_AMP:
+        CONTROL_PARAM(FM_PARAM_ATTACK,  0);
+        CONTROL_PARAM(FM_PARAM_DECAY,   1);
+        CONTROL_PARAM(FM_PARAM_SUSTAIN, 2);
+        CONTROL_PARAM(FM_PARAM_RELEASE, 3);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void FMSynth::draw(InstrumentPage page) {
+
+    switch (page) {
+    case INSTRUMENT_PAGE_OSC:
+        draw_osc();
+        break;
+    case INSTRUMENT_PAGE_FILTER:
+        draw_levels();
+        break;
+    case INSTRUMENT_PAGE_AMP:
+        draw_amp();
+        break;
+    default:
+        break;
+    }
+}
+
+void FMSynth::draw_osc(void) {
+    // Room for any int in both numbers, so the format can't be truncated
+    char name[3][32];
+    for (int op=1; op<FM_MAX_OPS; op++) {
+        snprintf(name[op-1], sizeof(name[0]), "Op %d x%d%s", op+1, ratio[op] >> 1, (ratio[op] & 1) ? ".5" : "");
+    }
+    draw_gauge_param(0, param[FM_PARAM_ALGORITHM], fm_algorithms[algorithm].name);
+    draw_gauge_param(1, param[FM_PARAM_RATIO_2], name[0]);
+    draw_gauge_param(2, param[FM_PARAM_RATIO_3], name[1]);
+    draw_gauge_param(3, param[FM_PARAM_RATIO_4], name[2]);
 }
 
-void TestSynth::draw_filter(void) {
-    draw_gauge_param(0, param[PARAM_TEST_FILTER], "Cutoff");
-    draw_gauge_param(1, param[PARAM_TEST_RES], "Res.");
+void FMSynth::draw_levels(void) {
+    draw_gauge_param(0, param[FM_PARAM_LEVEL_2], "Op 2 level");
+    draw_gauge_param(1, param[FM_PARAM_LEVEL_3], "Op 3 level");
+    draw_gauge_param(2, param[FM_PARAM_LEVEL_4], "Op 4 level");
+    draw_gauge_param(3, param[FM_PARAM_FEEDBACK], "Feedback");
 }
 
-void TestSynth::draw_amp(void) {
+void FMSynth::draw_amp(void) {
+    draw_gauge_param(0, param[FM_PARAM_ATTACK], "Attack");
+    draw_gauge_param(1, param[FM_PARAM_DECAY], "Decay");
+    draw_gauge_param(2, param[FM_PARAM_SUSTAIN], "Sustain");
+    draw_gauge_param(3, param[FM_PARAM_RELEASE], "Release");
 }
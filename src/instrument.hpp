@@ -1,5 +1,9 @@
 #pragma once
 #include "synth_common.hpp"
+#include "voice_pool.hpp"
+#include "modulation.hpp"
+#include "oversample.hpp"
+#include "sample.hpp"
 #include "input.h"
 #include "gfx/gfx.h"
 
@@ -16,12 +20,25 @@ class Instrument {
 public:
     Instrument() {}
     virtual void init() {}
-    virtual float process() { return 0.0f; }
+    // Render n samples into out. Note parameters are only changed between blocks.
+    virtual void process_block(sample_t *out, int n) { for (int i=0; i<n; i++) out[i] = 0; }
     virtual void control(InstrumentPage page, const InputState *input) {}
     virtual void draw(InstrumentPage page) {}
     virtual void silence() { gate = 0; }
+    // Work too slow for the audio callback, such as loading from the SD card.
+    // Called from the main loop.
+    virtual void background() {}
+
+    // Note events. By default these drive a single monophonic voice,
+    // and note_off is ignored if a different note has been played since.
+    virtual void note_on(int note, bool accent_on, bool retrigger);
+    virtual void note_off(int note);
+    virtual void set_param(int param, int value) {}
+    // True when the instrument will only output silence until the next note_on
+    virtual bool is_idle() { return !gate; }
 
     uint32_t note_freq;
+    int midi_note {-1};
     bool trigger;
     bool accent;
     bool gate;
@@ -38,25 +55,47 @@ typedef enum {
     AB_PARAM_FILTER,
     AB_PARAM_RES,
     AB_PARAM_ENVMOD,
+    AB_PARAM_WAVE,
+    AB_PARAM_LFO_RATE,
+    AB_PARAM_LFO_DEPTH,
     AB_NUM_PARAMS
 } AcidBassParam;
 
+// Oversampling for the filter: high resonance on a bright saw aliases badly
+#define AB_OVERSAMPLE 2
+
 class AcidBass : public Instrument {
 public:
     AcidBass();
     void init();
-    float process();
+    void process_block(sample_t *out, int n);
     void control(InstrumentPage page, const InputState *input);
     void draw(InstrumentPage page);
+    void set_param(int param, int value);
+    bool is_idle() { return !gate && env.level <= 0.0f; }
 
 private:
     int param[AB_NUM_PARAMS];
-    int env_mod;
     uint32_t cutoff;
     uint32_t resonance;    
+    float cutoff_smooth;    // knob values, smoothed at control rate
+    float res_smooth;
     Oscillator osc;
     ADSR env;
+    ModMatrix mod;
     SVFilter filter;
+    Oversampler oversampler;
+    sample_t os_buf[OVERSAMPLE_MAX * CONTROL_RATE_SAMPS];
+#ifdef AUDIO_Q15
+    SVFilterQ15 filter_q15;
+    int32_t cutoff_ramp;
+    int32_t amp_ramp;
+    int16_t env_buf[BUFFER_SIZE_SAMPS];
+    int16_t cutoff_buf[OVERSAMPLE_MAX * CONTROL_RATE_SAMPS];
+#else
+    float amp;
+    int16_t osc_buf[BUFFER_SIZE_SAMPS];
+#endif
 
     void draw_osc();
     void draw_filter();
@@ -67,28 +106,314 @@ private:
 
 
 typedef enum {
-    PARAM_TEST_FILTER,
-    PARAM_TEST_RES,
-    NUM_PARAM_TEST
-} TestSynthParam;
+    DR_PARAM_KICK_TUNE,
+    DR_PARAM_KICK_PUNCH,
+    DR_PARAM_KICK_DECAY,
+    DR_PARAM_SNARE_TONE,
+    DR_PARAM_SNARE_SNAP,
+    DR_PARAM_SNARE_DECAY,
+    DR_PARAM_HAT_TONE,
+    DR_PARAM_HAT_DECAY,
+    DR_PARAM_OPEN_HAT_DECAY,
+    DR_PARAM_CLAP_DECAY,
+    DR_NUM_PARAMS
+} DrumSynthParam;
+
+enum Drum {
+    DRUM_KICK,
+    DRUM_SNARE,
+    DRUM_CLAP,
+    DRUM_HAT,           // closed and open hats share a voice, so one chokes the other
+    NUM_DRUMS
+};
+
+// Level of each drum in the mix, and with accent
+#define DRUM_GAIN 0.6f
+#define DRUM_ACCENT_GAIN 1.0f
 
-class TestSynth : public Instrument {
+// The hand claps at the start of a clap, and the time between them
+#define DRUM_CLAP_BURSTS 3
+#define DRUM_CLAP_SPACING (SAMPLE_RATE / 100)
+
+struct DrumVoice {
+    ADSR env;               // attack then decay to zero, with the gate held
+    bool active;
+    float amp;              // envelope, ramped at control rate
+    float gain;             // for the note's accent
+    uint32_t phase[6];
+    SVFilter filter;
+};
+
+// Synthesised drum kit: kick, snare, clap and hi-hats, picked by note with the
+// General MIDI drum map. Everything is worked out from oscillators, filtered noise
+// and envelopes, so it needs no sample memory and no PSRAM bandwidth.
+class DrumSynth : public Instrument {
 public:
-    TestSynth();
+    DrumSynth();
     void init();
-    float process();
+    void process_block(sample_t *out, int n);
     void control(InstrumentPage page, const InputState *input);
     void draw(InstrumentPage page);
+    void note_on(int note, bool accent_on, bool retrigger);
+    void silence();
+    void set_param(int param, int value);
+    bool is_idle();
 
 private:
-    int param[NUM_PARAM_TEST];
-    uint32_t cutoff;
-    uint32_t resonance;    
-    Oscillator osc;
+    int param[DR_NUM_PARAMS];
+    DrumVoice voices[NUM_DRUMS];
+    float kick_base;        // phase increment at the end of the sweep
+    float kick_punch;       // sweep depth, as a multiple of the base pitch
+    float kick_sweep;       // sweep left, 1 to 0
+    float kick_sweep_decay; // per control period
+    uint32_t snare_freq[2];
+    float snare_snap;       // noise level
+    float snare_kf;         // filter coefficients
+    float hat_kf;
+    float clap_kf;
+    uint32_t hat_freq[6];
+    float hat_decay;
+    float open_hat_decay;
+    float clap_decay;
+    int clap_bursts;        // still to come
+    int clap_timer;         // samples to the next
+    int16_t noise[CONTROL_RATE_SAMPS];  // each drum takes its own run, so they don't correlate
+    float buf[BUFFER_SIZE_SAMPS];
+
+    void render_kick(DrumVoice *v, int pos, int len, float amp_step);
+    void render_snare(DrumVoice *v, int pos, int len, float amp_step);
+    void render_clap(DrumVoice *v, int pos, int len, float amp_step);
+    void render_hat(DrumVoice *v, int pos, int len, float amp_step);
+    void draw_kick();
+    void draw_snare();
+    void draw_hats();
+};
+
+
+
+typedef enum {
+    PS_PARAM_ATTACK,
+    PS_PARAM_DECAY,
+    PS_PARAM_SUSTAIN,
+    PS_PARAM_RELEASE,
+    PS_PARAM_FILTER,
+    PS_PARAM_RES,
+    PS_NUM_PARAMS
+} PolySynthParam;
+
+#define POLY_VOICES 8
+
+// Level of each voice in the mix, so that a few voices together don't clip
+#define POLY_VOICE_GAIN 0.25f
+
+// The voices are band limited and the filter is gentler here, so it runs at the
+// sample rate
+#define PS_OVERSAMPLE 1
+
+struct PolyVoice {
+    int midi_note;
+    bool gate;
+    uint32_t freq;
+    uint32_t phase;
     ADSR env;
+    int32_t amp_ramp;       // envelope level ramped at control rate, Q15 << 16
+    float amp;              // or in float
+
+    bool is_idle() { return !gate && env.level <= 0.0f; }
+    float level() { return env.level; }
+};
+
+// Polyphonic wavetable saw synth: a voice per note with its own envelope,
+// all going through one filter
+class PolySynth : public Instrument {
+public:
+    PolySynth();
+    void init();
+    void process_block(sample_t *out, int n);
+    void control(InstrumentPage page, const InputState *input);
+    void draw(InstrumentPage page);
+    void silence();
+    void note_on(int note, bool accent_on, bool retrigger);
+    void note_off(int note);
+    void set_param(int param, int value);
+    bool is_idle() { return voices.is_idle(); }
+
+private:
+    int param[PS_NUM_PARAMS];
+    uint32_t cutoff;
+    uint32_t resonance;
+    float cutoff_smooth;    // knob values, smoothed at control rate
+    float res_smooth;
+    VoicePool<PolyVoice, POLY_VOICES> voices;
     SVFilter filter;
+    Oversampler oversampler;
+    sample_t os_buf[OVERSAMPLE_MAX * CONTROL_RATE_SAMPS];
+#ifdef AUDIO_Q15
+    SVFilterQ15 filter_q15;
+    int32_t cutoff_ramp;
+    int16_t voice_buf[BUFFER_SIZE_SAMPS];
+    int16_t env_buf[BUFFER_SIZE_SAMPS];
+    int16_t cutoff_buf[OVERSAMPLE_MAX * CONTROL_RATE_SAMPS];
+    int32_t mix_buf[BUFFER_SIZE_SAMPS];
+#else
+    int16_t osc_buf[BUFFER_SIZE_SAMPS];
+#endif
 
-    void draw_osc();
     void draw_filter();
     void draw_amp();
 };
+
+
+
+typedef enum {
+    GR_PARAM_SAMPLE,
+    GR_PARAM_POSITION,
+    GR_PARAM_SPEED,
+    GR_PARAM_SPRAY,
+    GR_PARAM_SIZE,
+    GR_PARAM_DENSITY,
+    GR_PARAM_ATTACK,
+    GR_PARAM_RELEASE,
+    GR_PARAM_GRAINS,        // budget: most grains playing at once
+    GR_NUM_PARAMS
+} GranularParam;
+
+#define GRANULAR_MAX_GRAINS 16
+#define GRANULAR_DEFAULT_GRAINS 8
+
+// Highest grain pitch, as a ratio to the sample's root note
+#define GRANULAR_MAX_RATIO 4
+
+// Frames one grain can need for a buffer, with one more for interpolation
+#define GRANULAR_FETCH_FRAMES (GRANULAR_MAX_RATIO * BUFFER_SIZE_SAMPS + 2)
+
+struct Grain {
+    bool active;
+    int offset;             // where in the buffer the grain starts
+    int remaining;          // samples left to play
+    int32_t start;          // frame the grain started from
+    uint64_t phase;         // frames on from start, 32.32 fixed point
+    uint64_t inc;           // per output sample, for the pitch
+    uint32_t win_phase;     // through the window
+    uint32_t win_inc;
+};
+
+// Granular player for a sample loaded into PSRAM. Short windowed grains are taken
+// from around a play position which moves at its own speed, so pitch follows the
+// notes played while time runs at the speed set: stretched, or frozen at zero.
+//
+// New grains are started at control rate, up to the grain budget. The cost is
+// about the same for every grain, so the budget caps the CPU time the channel can
+// take. Each grain reads the frames it needs for a buffer in one burst.
+class Granular : public Instrument {
+public:
+    Granular();
+    void init();
+    void process_block(sample_t *out, int n);
+    void control(InstrumentPage page, const InputState *input);
+    void draw(InstrumentPage page);
+    void note_on(int note, bool accent_on, bool retrigger);
+    void set_param(int param, int value);
+    bool is_idle() { return !gate && env.level <= 0.0f; }
+    void background();
+
+private:
+    int param[GR_NUM_PARAMS];
+    int sample_id {-1};
+    volatile int load_id {-1};  // sample to switch to once the main loop has loaded it
+    uint64_t playhead;      // frames, 32.32 fixed point
+    volatile bool seek;     // move the playhead to the position set
+    uint32_t speed;         // frames per sample, 16.16 fixed point
+    int spray;              // random spread of grain starts, in frames
+    int grain_size;         // samples
+    float density;          // grains per second
+    float next_grain;       // fraction of the way to the next grain start
+    int grain_budget {GRANULAR_DEFAULT_GRAINS};
+    int32_t grain_gain;     // Q15, for the overlap of the grains
+    ADSR env;
+    int32_t amp_ramp;
+    Grain grains[GRANULAR_MAX_GRAINS];
+    int16_t fetch_buf[GRANULAR_FETCH_FRAMES];
+    int32_t mix_buf[BUFFER_SIZE_SAMPS];
+    int16_t env_buf[BUFFER_SIZE_SAMPS];
+
+    void start_grain(int offset, const SampleInfo *samp);
+    void render_grain(Grain *g, int id, int n);
+    void update_gain();
+    void draw_grain();
+    void draw_sample();
+    void draw_amp();
+};
+
+
+
+typedef enum {
+    FM_PARAM_ALGORITHM,
+    FM_PARAM_RATIO_2,
+    FM_PARAM_RATIO_3,
+    FM_PARAM_RATIO_4,
+    FM_PARAM_LEVEL_2,
+    FM_PARAM_LEVEL_3,
+    FM_PARAM_LEVEL_4,
+    FM_PARAM_FEEDBACK,
+    FM_PARAM_ATTACK,
+    FM_PARAM_DECAY,
+    FM_PARAM_SUSTAIN,
+    FM_PARAM_RELEASE,
+    FM_NUM_PARAMS
+} FMSynthParam;
+
+#define FM_MAX_OPS 4
+#define FM_VOICES 4
+#define FM_NUM_ALGORITHMS 5
+
+// Level of each voice in the mix
+#define FM_VOICE_GAIN 0.25f
+
+struct FMVoice {
+    int midi_note;
+    bool gate;
+    uint32_t freq;
+    uint32_t phase[FM_MAX_OPS];
+    ADSR env[FM_MAX_OPS];
+    int32_t amp_ramp[FM_MAX_OPS];   // envelope times level, Q15 << 16
+    int16_t fb_state[2];            // last outputs of the top operator
+
+    bool is_idle();
+    float level() { return env[0].level; }
+};
+
+// Polyphonic FM synth with 2 to 4 sine operators. The algorithm sets how many
+// operators play and which modulate which; the top one can feed back on itself.
+// Every operator has its own envelope, worked out at control rate, and the
+// operator level scales it. Operator 1 always plays at the note's pitch.
+class FMSynth : public Instrument {
+public:
+    FMSynth();
+    void init();
+    void process_block(sample_t *out, int n);
+    void control(InstrumentPage page, const InputState *input);
+    void draw(InstrumentPage page);
+    void silence();
+    void note_on(int note, bool accent_on, bool retrigger);
+    void note_off(int note);
+    void set_param(int param, int value);
+    bool is_idle() { return voices.is_idle(); }
+
+private:
+    int param[FM_NUM_PARAMS];
+    int algorithm;
+    uint32_t ratio[FM_MAX_OPS];     // to the note's pitch, 1 fractional bit
+    float level[FM_MAX_OPS];
+    int16_t feedback;               // Q15
+    VoicePool<FMVoice, FM_VOICES> voices;
+    int16_t op_buf[BUFFER_SIZE_SAMPS];
+    int16_t env_buf[BUFFER_SIZE_SAMPS];
+    uint32_t mod_buf[FM_MAX_OPS][BUFFER_SIZE_SAMPS];
+    int32_t mix_buf[BUFFER_SIZE_SAMPS];
+
+    void render_voice(FMVoice *voice, int n);
+    void draw_osc();
+    void draw_levels();
+    void draw_amp();
+};
@@ -0,0 +1,61 @@
+#include <math.h>
+#include "limiter.hpp"
+
+void Limiter::process(const mix_t *in, int16_t *out, int n) {
+    for (int pos=0; pos<n; pos+=LIMITER_CHUNK) {
+        const mix_t *chunk = &in[2*pos];
+
+        // Peak of the chunk coming in
+#ifdef AUDIO_Q15
+        int32_t peak_acc = 0;
+        for (int i=0; i<2*LIMITER_CHUNK; i++) {
+            int32_t x = chunk[i] < 0 ? -chunk[i] : chunk[i];
+            if (x > peak_acc) peak_acc = x;
+        }
+        const float peak = (float)peak_acc / (1 << Q15_MIX_GAIN_BITS);
+#else
+        float peak = 0.0f;
+        for (int i=0; i<2*LIMITER_CHUNK; i++) {
+            float x = fabsf(chunk[i]);
+            if (x > peak) peak = x;
+        }
+#endif
+
+        // Gain: instant attack, slow release
+        float g = gain + (1.0f - gain) * LIMITER_RELEASE;
+        if (peak * g > LIMITER_CEILING) g = LIMITER_CEILING / peak;
+
+        // Ramp over the delayed chunk to the lower of its gain and the next one's
+        const float end_gain = (g < gain) ? g : gain;
+
+#ifdef AUDIO_Q15
+        // Gain in Q30, applied as Q15
+        int32_t gq = start_gain * (1 << 30);
+        const int32_t step = (int32_t)(end_gain * (1 << 30) - gq) / LIMITER_CHUNK;
+        for (int i=0; i<2*LIMITER_CHUNK; i+=2) {
+            gq += step;
+            const int32_t g15 = gq >> 15;
+            for (int c=0; c<2; c++) {
+                int32_t s = ((int64_t)delay[i+c] * g15) >> (15 + Q15_MIX_GAIN_BITS);
+                out[2*pos + i+c] = q15_sat(s);
+                delay[i+c] = chunk[i+c];
+            }
+        }
+#else
+        float gf = start_gain;
+        const float step = (end_gain - start_gain) / LIMITER_CHUNK;
+        for (int i=0; i<2*LIMITER_CHUNK; i+=2) {
+            gf += step;
+            for (int c=0; c<2; c++) {
+                float s = delay[i+c] * gf;
+                CLAMP(s, -32767.0f, 32767.0f);
+                out[2*pos + i+c] = (int16_t)s;
+                delay[i+c] = chunk[i+c];
+            }
+        }
+#endif
+
+        gain = g;
+        start_gain = end_gain;
+    }
+}
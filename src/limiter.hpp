@@ -0,0 +1,40 @@
+#pragma once
+#include "synth_common.hpp"
+
+// Look-ahead limiter for the stereo master bus.
+//
+// The gain is worked out once per chunk of LIMITER_CHUNK samples from the chunk's
+// peak on either side, and ramped linearly per sample. Both sides get the same
+// gain so the stereo image doesn't move. Output is delayed by one chunk, so the gain
+// has already come down by the time a peak comes out: the gain where a chunk starts
+// and ends is never above what that chunk needs, so neither is the ramp in between.
+
+#define LIMITER_CHUNK CONTROL_RATE_SAMPS
+
+// Output ceiling, just under full scale
+#define LIMITER_CEILING 32000.0f
+
+// Fraction of the way back to unity gain per chunk, about 100 ms to recover
+#define LIMITER_RELEASE 0.003f
+
+#ifdef AUDIO_Q15
+// Mix accumulator, with Q15_MIX_GAIN_BITS fractional bits
+typedef int32_t mix_t;
+#else
+typedef float mix_t;
+#endif
+
+class Limiter {
+public:
+    // Limit n interleaved stereo samples (a multiple of LIMITER_CHUNK) of the mix
+    // into 16-bit output
+    void process(const mix_t *in, int16_t *out, int n);
+
+    // Current gain reduction, 1.0 = none
+    float get_gain() { return gain; }
+
+private:
+    float gain {1.0f};          // gain needed by the last chunk in
+    float start_gain {1.0f};    // gain at the start of the delayed chunk
+    mix_t delay[2*LIMITER_CHUNK];
+};
@@ -3,6 +3,7 @@
 #include "hw/oled.h"
 #include "input.h"
 #include "synth_common.hpp"
+#include "voice_pool.hpp"
 
 #include "audio.hpp"
 #include "userinterface.hpp"
@@ -43,11 +44,19 @@ int main(void) {
         }
 
         if (++ctr == 256) {
-            printf("perf:\taudio=%lld  cores=%lld,%lld\tui=%lld\n", 
+            printf("perf:\tbuf=%d  audio=%lld  overhead=%lld  cores=%lld,%lld (%d/%d ch)  mix=%lld  voices=%d/%d\tui=%lld  idle=%lld%%\n",
+                audio_get_buffer_size(),
                 perf_get(PERF_AUDIO),
+                perf_get(PERF_AUDIO_OVERHEAD),
                 perf_get(PERF_CHAN_CORE0),
                 perf_get(PERF_CHAN_CORE1),
-                perf_get(PERF_UI_UPDATE));
+                audio_get_channel_count(0),
+                audio_get_channel_count(1),
+                perf_get(PERF_MIX),
+                voices_active,
+                voice_limit,
+                perf_get(PERF_UI_UPDATE),
+                perf_get(PERF_IDLE));
             ctr = 0;
         }
     }
@@ -0,0 +1,59 @@
+#include <math.h>
+#include "modulation.hpp"
+#include "synth_common.hpp"
+
+
+uint32_t map_lfo_rate(int param) {
+    float hz = 0.05f * powf(400.0f, (float)param / PARAM_MAX);
+    return UINT32_MAX * (hz / SAMPLE_RATE);
+}
+
+static float process_lfo(LFO *lfo, int n) {
+    lfo->phase += lfo->rate * n;
+    const float p = (float)lfo->phase / (float)UINT32_MAX;
+
+    switch (lfo->shape) {
+    case LFO_TRI:       return (p < 0.5f) ? 4.0f*p - 1.0f : 3.0f - 4.0f*p;
+    case LFO_SAW:       return 2.0f*p - 1.0f;
+    case LFO_SQUARE:    return (p < 0.5f) ? 1.0f : -1.0f;
+    case LFO_SINE:      return sinf(2.0f * (float)M_PI * p);
+    default:            return 0.0f;
+    }
+}
+
+
+void ModMatrix::init() {
+    for (int s=0; s<MOD_SLOTS; s++) {
+        set_slot(s, MOD_SRC_NONE, MOD_SRC_NONE, MOD_DST_CUTOFF, 0.0f);
+    }
+    for (int l=0; l<NUM_LFOS; l++) {
+        lfo[l].shape = LFO_TRI;
+        lfo[l].rate = map_lfo_rate(64);
+        lfo[l].phase = 0;
+    }
+}
+
+void ModMatrix::set_slot(int slot, ModSource src, ModSource via, ModDest dst, float amount) {
+    if (slot < 0 || slot >= MOD_SLOTS) return;
+    slots[slot].src = src;
+    slots[slot].via = via;
+    slots[slot].dst = dst;
+    slots[slot].amount = amount;
+}
+
+void ModMatrix::process(int n, float env, bool accent, float *dest) {
+    sources[MOD_SRC_NONE] = 1.0f;   // so that 'via none' scales by 1
+    for (int l=0; l<NUM_LFOS; l++) {
+        sources[MOD_SRC_LFO1 + l] = process_lfo(&lfo[l], n);
+    }
+    sources[MOD_SRC_ENV] = env;
+    sources[MOD_SRC_ACCENT] = accent ? 1.0f : 0.0f;
+
+    for (int d=0; d<NUM_MOD_DESTS; d++) dest[d] = 0.0f;
+
+    for (int s=0; s<MOD_SLOTS; s++) {
+        const ModSlot *slot = &slots[s];
+        if (slot->src == MOD_SRC_NONE || slot->amount == 0.0f) continue;
+        dest[slot->dst] += sources[slot->src] * sources[slot->via] * slot->amount;
+    }
+}
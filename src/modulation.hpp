@@ -0,0 +1,75 @@
+#pragma once
+#include <stdint.h>
+
+// Modulation matrix, evaluated at control rate.
+//
+// The sources (LFOs, envelope, accent) are worked out once per control period and
+// shared by all slots, so each extra route costs a multiply-add per period rather
+// than anything per sample. Each slot adds source * amount to a destination,
+// optionally scaled by a second 'via' source.
+//
+// Destination units:
+//      MOD_DST_CUTOFF, MOD_DST_RES     parameter steps (0..PARAM_MAX)
+//      MOD_DST_PITCH                   semitones
+//      MOD_DST_AMP                     gain offset, 0 = unchanged, -1 = silent
+
+#define MOD_SLOTS 6
+#define NUM_LFOS 2
+
+enum ModSource {
+    MOD_SRC_NONE,
+    MOD_SRC_LFO1,       // -1..1
+    MOD_SRC_LFO2,
+    MOD_SRC_ENV,        // 0..1
+    MOD_SRC_ACCENT,     // 0 or 1
+    NUM_MOD_SOURCES
+};
+
+enum ModDest {
+    MOD_DST_CUTOFF,
+    MOD_DST_RES,
+    MOD_DST_PITCH,
+    MOD_DST_AMP,
+    NUM_MOD_DESTS
+};
+
+enum LFOShape {
+    LFO_TRI,
+    LFO_SAW,
+    LFO_SQUARE,
+    LFO_SINE,
+    NUM_LFO_SHAPES
+};
+
+struct LFO {
+    LFOShape shape;
+    uint32_t rate;      // phase increment per sample
+    uint32_t phase;
+};
+
+struct ModSlot {
+    uint8_t src;
+    uint8_t via;        // MOD_SRC_NONE for no scaling
+    uint8_t dst;
+    float amount;
+};
+
+// LFO rate from a knob parameter, 0.05 to 20 Hz
+uint32_t map_lfo_rate(int param);
+
+class ModMatrix {
+public:
+    void init();
+    void set_slot(int slot, ModSource src, ModSource via, ModDest dst, float amount);
+    void set_amount(int slot, float amount) { slots[slot].amount = amount; }
+
+    // Advance the LFOs by n samples, update the sources and sum up the
+    // modulation for each destination into dest[NUM_MOD_DESTS]
+    void process(int n, float env, bool accent, float *dest);
+
+    LFO lfo[NUM_LFOS];
+
+private:
+    ModSlot slots[MOD_SLOTS];
+    float sources[NUM_MOD_SOURCES];
+};
@@ -0,0 +1,101 @@
+#include "noise.hpp"
+#include "dsp_q15.hpp"
+
+#if PICO_ON_DEVICE
+#include "pico/platform.h"
+#define NOISE_CORES 2
+#define noise_core() get_core_num()
+#else
+#define NOISE_CORES 1
+#define noise_core() 0
+#endif
+
+// Any non-zero seeds, different so the cores don't give the same noise
+static uint32_t noise_state[NOISE_CORES] = {
+    0x2545f491,
+#if NOISE_CORES > 1
+    0x9e3779b9,
+#endif
+};
+
+static inline uint32_t xorshift32(uint32_t x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// Full scale down to NOISE_PEAK
+static inline int16_t noise_scale(int32_t x) {
+    return (x * NOISE_PEAK) >> 15;
+}
+
+uint32_t noise_rand(void) {
+    uint32_t *s = &noise_state[noise_core()];
+    const uint32_t x = xorshift32(*s);
+    *s = x;
+    return x;
+}
+
+void noise_white_block(int16_t *out, int n) {
+    // Keep the state in a register for the block
+    uint32_t *s = &noise_state[noise_core()];
+    uint32_t x = *s;
+    int i = 0;
+    for (; i+1<n; i+=2) {
+        x = xorshift32(x);
+        out[i] = noise_scale((int16_t)x);
+        out[i+1] = noise_scale((int16_t)(x >> 16));
+    }
+    if (i < n) {
+        x = xorshift32(x);
+        out[i] = noise_scale((int16_t)x);
+    }
+    *s = x;
+}
+
+void noise_pink_init(PinkNoise *p) {
+    p->count = 0;
+    p->sum = 0;
+    for (int r=0; r<NOISE_PINK_ROWS; r++) p->rows[r] = 0;
+}
+
+void noise_pink_block(PinkNoise *p, int16_t *out, int n) {
+    // Voss-McCartney: row k changes every 2^(k+1) samples, picked by the trailing
+    // zeros of a counter so only one row changes per sample. The sum of the rows
+    // plus a white term gives the slope. Each term is scaled down by 8 so that
+    // they rarely add up past full scale.
+    uint32_t *s = &noise_state[noise_core()];
+    uint32_t x = *s;
+    uint32_t count = p->count;
+    int32_t sum = p->sum;
+    for (int i=0; i<n; i++) {
+        x = xorshift32(x);
+        const int32_t white = (int16_t)x >> 3;
+        // A bit above the rows keeps the count from ever reaching zero
+        count = (count + 1) | (1u << NOISE_PINK_ROWS);
+        const int k = __builtin_ctz(count);
+        if (k < NOISE_PINK_ROWS) {
+            const int32_t row = (int32_t)x >> 19;
+            sum += row - p->rows[k];
+            p->rows[k] = row;
+        }
+        out[i] = noise_scale(q15_sat(sum + white));
+    }
+    p->count = count;
+    p->sum = sum;
+    *s = x;
+}
+
+void noise_sh_block(int16_t *out, uint32_t *phase, uint32_t dphase, int16_t *held, int n) {
+    uint32_t ph = *phase;
+    int16_t h = *held;
+    for (int i=0; i<n; i++) {
+        const uint32_t next = ph + dphase;
+        if (next < ph) h = noise_scale((int16_t)(noise_rand() >> 16));
+        ph = next;
+        out[i] = h;
+    }
+    *phase = ph;
+    *held = h;
+}
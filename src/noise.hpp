@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+
+// Noise sources, in Q15 blocks peaking at NOISE_PEAK.
+//
+// The generator is xorshift32, with one state per core so that either core, and
+// interrupts on it, can take noise without a lock. An interrupt landing in the
+// middle of a block on the same core can at worst repeat a short stretch of the
+// sequence, which can't be heard. Each step gives two samples, from the two
+// halves of the word.
+
+// Peak level of the noise, Q15. The wavetables are band-limited, so they hardly
+// overshoot going through the oversampler's half-band filters, but broadband
+// noise can come out at up to twice its peak. Half scale leaves room for that.
+#define NOISE_PEAK 16384
+
+// Rows of the pink noise generator. Each row changes half as often as the one
+// before, so this many octaves get the -3 dB/octave slope.
+#define NOISE_PINK_ROWS 8
+
+struct PinkNoise {
+    uint32_t count;
+    int32_t sum;
+    int16_t rows[NOISE_PINK_ROWS];
+};
+
+// A random word from this core's generator
+uint32_t noise_rand(void);
+
+// White noise, flat spectrum
+void noise_white_block(int16_t *out, int n);
+
+// Pink noise, -3 dB/octave. Quieter than white, about -19 dBFS rms.
+void noise_pink_init(PinkNoise *p);
+void noise_pink_block(PinkNoise *p, int16_t *out, int n);
+
+// Sample and hold: a new random level each time phase wraps, advancing phase by
+// dphase (from note_table) per sample. held is the current level.
+void noise_sh_block(int16_t *out, uint32_t *phase, uint32_t dphase, int16_t *held, int n);
@@ -0,0 +1,140 @@
+#include <string.h>
+#include "oversample.hpp"
+
+// Half-band filters, Kaiser windowed. Only the odd taps either side of the centre
+// are stored, doubled, in Q15: h[centre +/- (2j-1)] = coef[j-1] / 65536, and the
+// centre tap is 1/2.
+//
+// The first step passes up to 0.2 and stops from 0.3 of its output rate at -60 dB.
+// The second only has to pass up to 0.1 and stops from 0.4 at -63 dB.
+#ifdef AUDIO_Q15
+typedef int32_t coef_t;
+#else
+typedef float coef_t;
+#endif
+
+static const coef_t halfband_coef_1[HALFBAND_MAX_TAPS] = {
+    20703, -6492, 3441, -2031, 1212, -698, 374, -178, 69, -16
+};
+static const coef_t halfband_coef_2[4] = {
+    19706, -4112, 834, -44
+};
+
+struct HalfBandCoef {
+    const coef_t *coef;
+    int taps;
+};
+
+static const HalfBandCoef halfband[2] = {
+    {halfband_coef_1, HALFBAND_MAX_TAPS},
+    {halfband_coef_2, 4},
+};
+
+
+// Sum of the non-centre taps for the point between w[taps-1] and w[taps], for a
+// window of 2*taps samples. In Q15 this has 15 fractional bits, and needs 64 bits:
+// full scale tap pairs through the first filter can reach 35214 * 65534.
+#ifdef AUDIO_Q15
+static inline int64_t halfband_sum(const HalfBandCoef *hb, const sample_t *w) {
+    const int taps = hb->taps;
+    int64_t acc = 0;
+    for (int j=1; j<=taps; j++) {
+        acc += (int64_t)hb->coef[j-1] * (w[taps-1+j] + w[taps-j]);
+    }
+    return acc;
+}
+#else
+static inline float halfband_sum(const HalfBandCoef *hb, const sample_t *w) {
+    const int taps = hb->taps;
+    float acc = 0.0f;
+    for (int j=1; j<=taps; j++) {
+        acc += hb->coef[j-1] * (w[taps-1+j] + w[taps-j]);
+    }
+    return acc * (1.0f / 32768);
+}
+#endif
+
+// Keep the last 2*taps-1 samples of a buffer holding n new ones
+static inline void halfband_shift(sample_t *buf, int taps, int n) {
+    memmove(buf, &buf[n], (2*taps - 1) * sizeof(sample_t));
+}
+
+// 2x: each input sample gives the filtered sample before it, then itself delayed
+static void halfband_up(HalfBand *s, const HalfBandCoef *hb, const sample_t *in, sample_t *out, int n) {
+    const int taps = hb->taps;
+    sample_t *x = s->x;
+    memcpy(&x[2*taps - 1], in, n * sizeof(sample_t));
+
+    for (int i=0; i<n; i++) {
+        const sample_t *w = &x[i];
+#ifdef AUDIO_Q15
+        out[2*i] = q15_sat(halfband_sum(hb, w) >> 15);
+#else
+        out[2*i] = halfband_sum(hb, w);
+#endif
+        out[2*i+1] = w[taps];
+    }
+
+    halfband_shift(x, taps, n);
+}
+
+// 2x down: filter the even phase and add the centre tap from the odd phase
+static void halfband_down(HalfBand *s, const HalfBandCoef *hb, const sample_t *in, sample_t *out, int n) {
+    const int taps = hb->taps;
+    sample_t *even = s->x;
+    sample_t *odd = s->odd;
+    for (int i=0; i<n; i++) {
+        even[2*taps - 1 + i] = in[2*i];
+        odd[2*taps - 1 + i] = in[2*i+1];
+    }
+
+    for (int i=0; i<n; i++) {
+        // The stored taps are doubled, so halve along with the centre tap
+#ifdef AUDIO_Q15
+        const int64_t acc = halfband_sum(hb, &even[i]) + ((int64_t)odd[i + taps - 1] << 15);
+        out[i] = q15_sat(acc >> 16);
+#else
+        out[i] = 0.5f * (halfband_sum(hb, &even[i]) + odd[i + taps - 1]);
+#endif
+    }
+
+    halfband_shift(even, taps, n);
+    halfband_shift(odd, taps, n);
+}
+
+
+void Oversampler::init(int f) {
+    factor = (f >= 4) ? 4 : (f >= 2) ? 2 : 1;
+    memset(up_stage, 0, sizeof(up_stage));
+    memset(down_stage, 0, sizeof(down_stage));
+}
+
+void Oversampler::up(const sample_t *in, sample_t *out, int n) {
+    switch (factor) {
+    case 2:
+        halfband_up(&up_stage[0], &halfband[0], in, out, n);
+        break;
+    case 4:
+        halfband_up(&up_stage[0], &halfband[0], in, work, n);
+        halfband_up(&up_stage[1], &halfband[1], work, out, 2*n);
+        break;
+    default:
+        if (out != in) memcpy(out, in, n * sizeof(sample_t));
+        break;
+    }
+}
+
+void Oversampler::down(const sample_t *in, sample_t *out, int n) {
+    switch (factor) {
+    case 2:
+        halfband_down(&down_stage[0], &halfband[0], in, out, n);
+        break;
+    case 4:
+        halfband_down(&down_stage[1], &halfband[1], in, work, 2*n);
+        halfband_down(&down_stage[0], &halfband[0], work, out, n);
+        break;
+    default:
+        if (out != in) memcpy(out, in, n * sizeof(sample_t));
+        break;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "synth_common.hpp"
+
+// Oversampling for the parts of an instrument that alias.
+//
+// up() raises a run of samples to 2x or 4x the sample rate and down() brings it back,
+// so an instrument only pays the higher rate inside the stage it wraps. Each 2x step
+// is a polyphase half-band FIR: every other tap is zero apart from the centre one, so
+// upsampling copies the input through on one phase and filters only the other, and
+// decimating filters only the samples it keeps. 4x is two steps, the second with a
+// shorter filter since everything above half the first step's rate is already gone.
+//
+// Latency through up() and down() together is 19 samples at 2x, about 22 at 4x.
+
+#define OVERSAMPLE_MAX 4
+
+// Largest run for up() and down(), at the base rate
+#define OVERSAMPLE_MAX_SAMPS CONTROL_RATE_SAMPS
+
+// Taps on the non-zero phase of the longest half-band filter
+#define HALFBAND_MAX_TAPS 10
+
+// Input history plus a run at 2x, the most any one step sees
+#define HALFBAND_BUF_SAMPS (2*HALFBAND_MAX_TAPS - 1 + 2*OVERSAMPLE_MAX_SAMPS)
+
+struct HalfBand {
+    sample_t x[HALFBAND_BUF_SAMPS];     // input, or the even phase when decimating
+    sample_t odd[HALFBAND_BUF_SAMPS];   // odd phase when decimating
+};
+
+class Oversampler {
+public:
+    // Factor of 1, 2 or 4. Clears the filter state.
+    void init(int factor);
+    int get_factor() { return factor; }
+
+    // Upsample n samples into n*factor samples in out
+    void up(const sample_t *in, sample_t *out, int n);
+
+    // Filter and decimate n*factor samples from in into n samples in out
+    void down(const sample_t *in, sample_t *out, int n);
+
+private:
+    int factor {1};
+    HalfBand up_stage[2];
+    HalfBand down_stage[2];
+    sample_t work[2*OVERSAMPLE_MAX_SAMPS];
+};
@@ -0,0 +1,141 @@
+#include <math.h>
+#include <string.h>
+#include "reverb.hpp"
+
+// Line lengths in samples, mutually prime so the echoes don't line up. Low quality
+// uses the second set, spread across the same range.
+static const uint16_t reverb_lengths_high[8] = {1103, 1277, 1427, 1601, 1747, 1867, 2053, 2251};
+static const uint16_t reverb_lengths_low[4] = {1277, 1601, 1867, 2251};
+
+
+void Reverb::init() {
+    set_quality(REVERB_OFF);
+    set_damping(0.3f);
+    set_level(0.5f);
+    start(REVERB_OFF);
+}
+
+void Reverb::set_quality(int q) {
+    if (q < 0 || q >= NUM_REVERB_QUALITY) return;
+    new_quality = q;
+}
+
+void Reverb::start(int q) {
+    quality = q;
+    num_lines = (q == REVERB_HIGH) ? 8 : 4;
+    lengths = (q == REVERB_HIGH) ? reverb_lengths_high : reverb_lengths_low;
+
+    // Lay the lines out one after another, and start from silence
+    memset(mem, 0, sizeof(mem));
+    int16_t *p = mem;
+    for (int l=0; l<num_lines; l++) {
+        line[l] = p;
+        p += lengths[l];
+        pos[l] = 0;
+        lp[l] = 0;
+    }
+    apply_params();
+}
+
+void Reverb::set_decay(float seconds) {
+    CLAMP(seconds, 0.1f, 20.0f);
+    decay = seconds;
+    params_changed = true;
+}
+
+void Reverb::set_damping(float d) {
+    CLAMP(d, 0.0f, 0.95f);
+    damping = d;
+    params_changed = true;
+}
+
+void Reverb::set_level(float lvl) {
+    CLAMP(lvl, 0.0f, 1.0f);
+    wet = lvl;
+    params_changed = true;
+}
+
+// Only called from process(), so the line setup can't change underneath it
+void Reverb::apply_params() {
+    // Clear first, so a change made while this runs is picked up next time
+    params_changed = false;
+
+    // Each pass round a line loses 60 dB * length / decay time, and the
+    // Hadamard matrix needs scaling by 1/sqrt(lines) to keep its gain at 1
+    const float seconds = decay;
+    const float matrix_scale = 1.0f / sqrtf(num_lines);
+    for (int l=0; l<num_lines; l++) {
+        const float g = powf(10.0f, -3.0f * lengths[l] / (seconds * SAMPLE_RATE));
+        gain[l] = g * matrix_scale * 32767;
+    }
+
+    damp = (1.0f - damping) * 32767;
+
+    // Each side sums half the lines, so keep the level the same whichever quality
+    const float out_scale = wet * sqrtf(2.0f / num_lines);
+#ifdef AUDIO_Q15
+    level = out_scale * (1 << Q15_MIX_GAIN_BITS);
+#else
+    level = out_scale;
+#endif
+}
+
+
+// Q15 multiply, rounded: truncating would leave the tail stuck at a small offset
+static inline int32_t mul_q15_round(int32_t a, int32_t b) {
+    return (int32_t)(((int64_t)a * b + (1 << 14)) >> 15);
+}
+
+// In-place Hadamard transform of n values, n a power of two
+static inline void hadamard(int32_t *x, int n) {
+    for (int h=1; h<n; h*=2) {
+        for (int i=0; i<n; i+=2*h) {
+            for (int j=i; j<i+h; j++) {
+                const int32_t a = x[j];
+                const int32_t b = x[j+h];
+                x[j] = a + b;
+                x[j+h] = a - b;
+            }
+        }
+    }
+}
+
+bool Reverb::process(const mix_t *send, mix_t *out, int n) {
+    if (new_quality != quality) start(new_quality);
+    else if (params_changed) apply_params();
+    if (quality == REVERB_OFF) return false;
+
+    const int lines = num_lines;
+    int32_t x[REVERB_MAX_LINES];
+
+    for (int i=0; i<n; i++) {
+#ifdef AUDIO_Q15
+        const int32_t in = send[i] >> Q15_MIX_GAIN_BITS;
+#else
+        const int32_t in = send[i];
+#endif
+
+        // Line outputs, damped, and alternately to left and right
+        int32_t left = 0;
+        int32_t right = 0;
+        for (int l=0; l<lines; l++) {
+            const int32_t y = line[l][pos[l]];
+            lp[l] += mul_q15_round((y << REVERB_DAMP_BITS) - lp[l], damp);
+            x[l] = (lp[l] + (1 << (REVERB_DAMP_BITS - 1))) >> REVERB_DAMP_BITS;
+            if (l & 1) right += y; else left += y;
+        }
+
+        hadamard(x, lines);
+
+        // Back into the lines with the send
+        for (int l=0; l<lines; l++) {
+            line[l][pos[l]] = q15_sat(in + mul_q15_round(x[l], gain[l]));
+            if (++pos[l] == lengths[l]) pos[l] = 0;
+        }
+
+        out[2*i]   = left * level;
+        out[2*i+1] = right * level;
+    }
+
+    return true;
+}
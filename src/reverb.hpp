@@ -0,0 +1,71 @@
+#pragma once
+#include "synth_common.hpp"
+#include "limiter.hpp"
+
+// Feedback delay network reverb, in fixed point.
+//
+// Each line's output goes through a one-pole lowpass for damping, then all of them
+// through a Hadamard matrix (adds and subtracts only) and back into the lines with
+// the send. The lines are 16-bit and live in SRAM, in the instance itself. Quality
+// sets how many lines run: more lines give a denser tail, at roughly proportional cost.
+//
+// Output is stereo, from alternate lines on each side.
+
+#define REVERB_MAX_LINES 8
+
+// Line memory, the sum of the high quality line lengths
+#define REVERB_MEM_SAMPS (1103 + 1277 + 1427 + 1601 + 1747 + 1867 + 2053 + 2251)
+
+enum ReverbQuality {
+    REVERB_OFF,
+    REVERB_LOW,         // 4 lines
+    REVERB_HIGH,        // 8 lines
+    NUM_REVERB_QUALITY
+};
+
+// Fractional bits of the damping filter state
+#define REVERB_DAMP_BITS 8
+
+class Reverb {
+public:
+    void init();
+    // Takes effect, from silence, at the next process()
+    void set_quality(int quality);
+    int get_quality() { return new_quality; }
+    // These are safe to call while process() runs on the other core: they take
+    // effect at the start of its next buffer.
+    // Time for the tail to fall by 60 dB
+    void set_decay(float seconds);
+    // High frequency damping, 0 (none) to 1
+    void set_damping(float damping);
+    void set_level(float level);
+
+    // Feed in n samples of send and write n interleaved stereo samples, at mix scale,
+    // to out. Does nothing and returns false when off.
+    bool process(const mix_t *send, mix_t *out, int n);
+
+private:
+    int quality {REVERB_OFF};
+    volatile int new_quality {REVERB_OFF};
+    int num_lines;
+    const uint16_t *lengths;    // of the lines in use
+    volatile float decay {1.5f};
+    volatile float damping {0.3f};
+    volatile float wet {0.5f};
+    volatile bool params_changed;   // since process() last applied them
+
+    int16_t mem[REVERB_MEM_SAMPS];
+    int16_t *line[REVERB_MAX_LINES];
+    uint16_t pos[REVERB_MAX_LINES];
+    int32_t lp[REVERB_MAX_LINES];
+    int16_t gain[REVERB_MAX_LINES];     // Q15, decay and matrix scaling
+    int16_t damp;                       // Q15 lowpass coefficient
+#ifdef AUDIO_Q15
+    int16_t level;                      // Q15_MIX_GAIN_BITS, with the scaling for the lines
+#else
+    float level;
+#endif
+
+    void start(int quality);
+    void apply_params();
+};
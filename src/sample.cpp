@@ -69,6 +69,10 @@ int build_list() {
             samp.addr = -1;
             samp.root_midi_note = DEFAULT_SAMPLE_ROOT_NOTE;
             samp.is_loaded = false;
+            samp.mode = SAMPLE_ONESHOT;
+            samp.choke_group = 0;
+            samp.start = 0;
+            samp.end = samp.length;
             strlcpy(samp.name, sample_name, sizeof(samp.name));
 
             sample_list.push_back(samp);
@@ -180,6 +184,27 @@ int16_t fetch(int sample_id, int pos) {
     return *(int16_t*)&data;
 }
 
+void fetch_block(int sample_id, int pos, int16_t *buf, int n) {
+    SampleInfo *samp = get_sample_info(sample_id);
+    if (!samp || !samp->is_loaded) {
+        memset(buf, 0, n * sizeof(int16_t));
+        return;
+    }
+
+    // Part of the block before the start or after the end
+    int first = (pos < 0) ? -pos : 0;
+    if (first > n) first = n;
+    int last = (int)samp->length - pos;
+    if (last > n) last = n;
+    if (last < first) last = first;
+
+    memset(buf, 0, first * sizeof(int16_t));
+    if (last > first) {
+        psram_read(samp->addr + FRAME_SIZE*(pos + first), (uint8_t*)&buf[first], FRAME_SIZE*(last - first));
+    }
+    memset(&buf[last], 0, (n - last) * sizeof(int16_t));
+}
+
 SampleInfo *get_info(int sample_id) {
     return get_sample_info(sample_id);
 }
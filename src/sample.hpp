@@ -7,6 +7,14 @@
 #define SAMPLES_DIR "samples"
 #define DEFAULT_SAMPLE_ROOT_NOTE 60
 
+// How a sample plays when triggered
+enum SampleMode {
+    SAMPLE_ONESHOT,         // start to end
+    SAMPLE_LOOP,            // start to end, repeated until the step's gate ends
+    SAMPLE_REVERSE,         // end to start
+    NUM_SAMPLE_MODES
+};
+
 struct SampleInfo {
     int sample_id;
     size_t length;
@@ -16,6 +24,12 @@ struct SampleInfo {
     unsigned int root_midi_note;
     int32_t addr;
     char name[SAMPLE_NAME_SIZE];
+
+    // Playback settings
+    uint8_t mode;
+    uint8_t choke_group;    // 0 for none
+    uint32_t start;         // frames, end exclusive
+    uint32_t end;
 };
 
 
@@ -38,4 +52,8 @@ namespace SampleManager {
 
     // Fetch a single... sample from a sample
     int16_t fetch(int sample_id, int pos);
+
+    // Fetch n frames starting at pos in one PSRAM read. Frames outside the
+    // sample, including negative positions, are silence.
+    void fetch_block(int sample_id, int pos, int16_t *buf, int n);
 }
\ No newline at end of file
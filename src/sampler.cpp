@@ -0,0 +1,144 @@
+#include <string.h>
+#include "sampler.hpp"
+
+void Sampler::init() {
+    silence();
+    trigger_count = 0;
+}
+
+void Sampler::set_max_voices(int n) {
+    CLAMP(n, 1, SAMPLER_MAX_VOICES);
+    max_voices = n;
+}
+
+void Sampler::silence() {
+    for (int i=0; i<SAMPLER_MAX_VOICES; i++) {
+        voices[i].sample_id = -1;
+    }
+}
+
+bool Sampler::is_idle() {
+    for (int i=0; i<SAMPLER_MAX_VOICES; i++) {
+        if (voices[i].sample_id >= 0) return false;
+    }
+    return true;
+}
+
+void Sampler::trigger(int sample_id, int midi_note, uint16_t trigger_id) {
+    if (sample_id < 0) return;
+    SampleInfo *samp = SampleManager::get_info(sample_id);
+    if (!samp || !samp->is_loaded) return;
+
+    int32_t end = samp->end;
+    if (end > (int32_t)samp->length) end = samp->length;
+    if (end <= (int32_t)samp->start) return;
+
+    // Stop anything in the same choke group
+    if (samp->choke_group) {
+        for (int i=0; i<SAMPLER_MAX_VOICES; i++) {
+            if (voices[i].choke_group == samp->choke_group) voices[i].sample_id = -1;
+        }
+    }
+
+    // Take a free voice, or the oldest if the channel is playing all it can
+    SamplerVoice *v = NULL;
+    SamplerVoice *oldest = NULL;
+    int active = 0;
+    for (int i=0; i<SAMPLER_MAX_VOICES; i++) {
+        SamplerVoice *w = &voices[i];
+        if (w->sample_id < 0) {
+            if (!v) v = w;
+        } else {
+            active++;
+            if (!oldest || (int32_t)(w->started - oldest->started) < 0) oldest = w;
+        }
+    }
+    if (active >= max_voices && oldest) v = oldest;
+    if (!v) return;
+
+    uint32_t play_freq = midi_note_to_freq(midi_note);
+    uint32_t root_freq = midi_note_to_freq(samp->root_midi_note);
+
+    v->sample_id = sample_id;
+    v->mode = samp->mode;
+    v->choke_group = samp->choke_group;
+    v->trigger_id = trigger_id;
+    v->released = false;
+    v->started = trigger_count++;
+    v->start = samp->start;
+    v->length = end - samp->start;
+    v->phase = 0;
+    v->inc = root_freq ? ((uint64_t)play_freq << 32) / root_freq : (1ULL << 32);
+    v->block_len = 0;
+}
+
+void Sampler::release(uint16_t trigger_id) {
+    for (int i=0; i<SAMPLER_MAX_VOICES; i++) {
+        SamplerVoice *v = &voices[i];
+        if (v->sample_id >= 0 && v->trigger_id == trigger_id) v->released = true;
+    }
+}
+
+void Sampler::process(sample_t *out, int n) {
+    memset(out, 0, n * sizeof(sample_t));
+    for (int i=0; i<SAMPLER_MAX_VOICES; i++) {
+        SamplerVoice *v = &voices[i];
+        if (v->sample_id >= 0 && !render_voice(v, out, n)) {
+            v->sample_id = -1;
+        }
+    }
+}
+
+bool Sampler::render_voice(SamplerVoice *v, sample_t *out, int n) {
+    // Reverse playback reads the same window of frames, mirrored
+    const bool reverse = (v->mode == SAMPLE_REVERSE);
+    const int dir = reverse ? -1 : 1;
+    const int lo = reverse ? -2 : -1;
+    const int hi = reverse ? 1 : 2;
+    const bool hermite = (interp == SAMPLE_INTERP_HERMITE);
+
+    for (int i=0; i<n; i++) {
+        int32_t t = v->phase >> 32;
+        if (t >= v->length) {
+            if (v->mode != SAMPLE_LOOP || v->released) return false;
+            t %= v->length;
+            v->phase = ((uint64_t)t << 32) | (uint32_t)v->phase;
+        }
+        const int32_t pos = reverse ? v->start + v->length - 1 - t : v->start + t;
+
+        // Frames pos-dir..pos+2*dir need to be in the block, otherwise fetch
+        // the next block in the direction of playback
+        int32_t idx = pos - v->block_pos;
+        if (idx + lo < 0 || idx + hi >= v->block_len) {
+            v->block_pos = reverse ? pos + hi + 1 - SAMPLER_BLOCK_FRAMES : pos + lo;
+            v->block_len = SAMPLER_BLOCK_FRAMES;
+            SampleManager::fetch_block(v->sample_id, v->block_pos, v->block, SAMPLER_BLOCK_FRAMES);
+            idx = pos - v->block_pos;
+        }
+
+        const int16_t *x = &v->block[idx];
+        const int32_t xm1 = x[-dir];
+        const int32_t x0 = x[0];
+        const int32_t x1 = x[dir];
+        const int32_t frac = (uint32_t)v->phase >> 17;     // Q15
+        int32_t s;
+        if (hermite) {
+            // Catmull-Rom, with the coefficients doubled to keep them integer
+            const int32_t x2 = x[2*dir];
+            const int32_t c1 = x1 - xm1;
+            const int32_t c2 = 2*xm1 - 5*x0 + 4*x1 - x2;
+            const int32_t c3 = (x2 - xm1) + 3*(x0 - x1);
+            s = x0 + (q15_mul32(q15_mul32(q15_mul32(c3, frac) + c2, frac) + c1, frac) >> 1);
+        } else {
+            s = x0 + q15_mul32(x1 - x0, frac);
+        }
+        v->phase += v->inc;
+
+#ifdef AUDIO_Q15
+        out[i] = q15_sat(out[i] + int16_to_sample(q15_sat(s)));
+#else
+        out[i] += int16_to_sample(q15_sat(s));
+#endif
+    }
+    return true;
+}
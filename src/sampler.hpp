@@ -0,0 +1,76 @@
+#pragma once
+#include "synth_common.hpp"
+#include "sample.hpp"
+
+// Sample playback for sample channels, with several voices so that a new step
+// doesn't cut off the tail of the last one.
+//
+// Each voice keeps a block of its sample's frames in SRAM and refills it from
+// PSRAM in one burst when playback runs off the end, so a voice at the original
+// pitch costs about one read per buffer. Voices are added into the output with
+// the headroom of the channel format, so a few can overlap at full level.
+//
+// Mode, start and end offsets and choke group are settings of the sample, taken
+// when a voice starts. Starting a sample stops any voices in the same choke
+// group on the channel, as for an open hi-hat being closed.
+
+#define SAMPLER_MAX_VOICES 4
+#define SAMPLER_DEFAULT_VOICES 4
+
+// Frames held per voice. A buffer at the original pitch, plus the neighbours
+// needed for interpolation, takes one fetch.
+#define SAMPLER_BLOCK_FRAMES (BUFFER_SIZE_SAMPS + 4)
+
+enum SampleInterp {
+    SAMPLE_INTERP_LINEAR,
+    SAMPLE_INTERP_HERMITE,      // 4-point, 3rd order
+    NUM_SAMPLE_INTERP
+};
+
+struct SamplerVoice {
+    int sample_id {-1};         // -1 when free
+    uint8_t mode;
+    uint8_t choke_group;
+    uint16_t trigger_id;        // given by the trigger, for its release
+    bool released;              // a loop plays on to the end once released
+    uint32_t started;           // trigger count when started, to find the oldest
+    int32_t start;              // frames of the sample to play, end exclusive
+    int32_t length;
+    uint64_t phase;             // frames played, 32.32 fixed point
+    uint64_t inc;               // per output sample
+
+    // Block of the sample's frames, starting at block_pos
+    int32_t block_pos;
+    int block_len;
+    int16_t block[SAMPLER_BLOCK_FRAMES];
+};
+
+class Sampler {
+public:
+    void init();
+    // Voices a channel can play at once. Above this the oldest voice is stopped.
+    void set_max_voices(int n);
+    int get_max_voices() { return max_voices; }
+
+    // Start a sample at the pitch of a MIDI note, relative to its root note.
+    // trigger_id picks out the voice for release().
+    void trigger(int sample_id, int midi_note, uint16_t trigger_id);
+    // End of the gate for the voice started with this trigger_id. A later trigger
+    // of the same sample and note plays on.
+    void release(uint16_t trigger_id);
+    void silence();
+    bool is_idle();
+
+    // Render n samples of all voices into out
+    void process(sample_t *out, int n);
+
+    int interp {SAMPLE_INTERP_LINEAR};
+
+private:
+    SamplerVoice voices[SAMPLER_MAX_VOICES];
+    int max_voices {SAMPLER_DEFAULT_VOICES};
+    uint32_t trigger_count;
+
+    // Add a voice into out. Returns false once it has finished.
+    bool render_voice(SamplerVoice *v, sample_t *out, int n);
+};
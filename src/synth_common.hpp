@@ -3,6 +3,11 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "common.h"
+#include "dsp_q15.hpp"
+#include "wavetable.hpp"
+#include "noise.hpp"
+#include "tables/tables.h"
 
 #define CLAMP(x, xmin, xmax) if ((x)>(xmax)) x=(xmax); else if ((x)<(xmin)) x=(xmin);
 #define CLAMP127(x) CLAMP(x, 0, 127)
@@ -17,13 +22,43 @@
 
 void create_lookup_tables(void);
 float exp_lookup(float arg);
-extern uint32_t note_table[MIDI_NOTE_TABLE_LEN];
 
 uint32_t midi_note_to_freq(unsigned int midi_note);
+// Phase increment for a pitch in cents, 100 * MIDI note number
+uint32_t midi_cents_to_freq(int cents);
 int midi_note_to_str(char *buf, size_t bufsize, unsigned int midi_note);
 
 
 
+/************************************************/
+// Channel sample format
+// Either float, or Q15 scaled down by Q15_HEADROOM_BITS (see dsp_q15.hpp)
+
+#ifdef AUDIO_Q15
+typedef int16_t sample_t;
+static inline sample_t to_sample(float x) { return q15_sat((int32_t)(x * Q15_CHANNEL_ONE)); }
+static inline sample_t int16_to_sample(int16_t x) { return x >> Q15_HEADROOM_BITS; }
+#else
+typedef float sample_t;
+static inline sample_t to_sample(float x) { return x; }
+static inline sample_t int16_to_sample(int16_t x) { return x / 32768.0f; }
+#endif
+
+
+
+/************************************************/
+// Control rate
+//
+// Envelopes, modulation and filter coefficients are worked out once every
+// CONTROL_RATE_SAMPS samples and ramped linearly in between. Values set by knobs
+// also move towards their new setting over a few control periods, so turning a
+// knob doesn't make zipper noise.
+
+#define CONTROL_RATE_SAMPS 16
+#define CONTROL_SMOOTHING 0.125f
+
+
+
 /************************************************/
 // ADSR envelope
 
@@ -46,6 +81,8 @@ struct ADSR {
 };
 
 float process_adsr(ADSR *e, bool gate);
+// Advance the envelope by n samples at once, for use at control rate
+float process_adsr_n(ADSR *e, bool gate, int n);
 float map_attack(int param);
 float map_sustain(int param);
 float map_decay(int param);
@@ -69,20 +106,38 @@ struct SVFilter {
 
 float process_svfilter(SVFilter *f, float in);
 float svfreq_map(uint32_t param);
+int16_t svfreq_map_q15(uint32_t param);
+
+// Cutoff map with SVFREQ_FINE_BITS of parameter, interpolated, for smoothed and
+// modulated cutoffs that fall between knob steps
+#define SVFREQ_FINE_SCALE (1 << (SVFREQ_FINE_BITS - PARAM_BITS))
+float svfreq_map_fine(uint32_t param);
+int16_t svfreq_map_fine_q15(uint32_t param);
+
+// The svfreq_map() values are tuned for a filter running at twice the sample rate.
+// These rescale one for a filter running at oversample times the rate.
+float svfreq_oversample(float kf, int oversample);
+int16_t svfreq_oversample_q15(int16_t kf, int oversample);
 
 
 
 /************************************************/
 // Oscillators
 
+// The wavetables, then the noise sources
 enum OscWave {
-    WAVE_TRI,
-    WAVE_SQUARE,
-    WAVE_SAW,
-    WAVE_NOISE,
+    WAVE_SAW = WT_SAW,
+    WAVE_SQUARE = WT_SQUARE,
+    WAVE_TRI = WT_TRI,
+    WAVE_USER = WT_USER,
+    WAVE_NOISE = NUM_WAVETABLES,    // white
+    WAVE_PINK_NOISE,
+    WAVE_SH_NOISE,                  // sample and hold, at the oscillator frequency
     NUM_WAVE
 };
 
+extern const char *osc_wave_names[NUM_WAVE];
+
 struct Oscillator {
     // Parameters
     OscWave waveform;
@@ -91,8 +146,14 @@ struct Oscillator {
     float gain;
     // State
     uint32_t phase;
+    PinkNoise pink;
+    int16_t held;
 };
 
+void oscillator_init(Oscillator *osc);
+// Render n full scale Q15 samples of the oscillator's waveform
+void oscillator_block(Oscillator *osc, int16_t *out, uint32_t dphase, int n);
+
 static inline float polyblep(uint32_t t, uint32_t dt) {
 
     if (t < dt) {
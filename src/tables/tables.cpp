@@ -0,0 +1,793 @@
+// Autogenerated file
+#include "tables.h"
+
+const float exp_table[1024] = {
+1.0f,1.00097704f,1.00195503f,1.00293398f,1.00391389f,1.00489475f,1.00587657f,1.00685936f,
+1.0078431f,1.0088278f,1.00981346f,1.01080009f,1.01178768f,1.01277624f,1.01376576f,1.01475625f,
+1.01574771f,1.01674013f,1.01773353f,1.0187279f,1.01972323f,1.02071954f,1.02171683f,1.02271508f,
+1.02371432f,1.02471453f,1.02571571f,1.02671788f,1.02772102f,1.02872515f,1.02973025f,1.03073634f,
+1.03174341f,1.03275146f,1.0337605f,1.03477053f,1.03578154f,1.03679354f,1.03780652f,1.0388205f,
+1.03983547f,1.04085143f,1.04186838f,1.04288633f,1.04390527f,1.04492521f,1.04594614f,1.04696807f,
+1.047991f,1.04901493f,1.05003986f,1.05106579f,1.05209272f,1.05312066f,1.0541496f,1.05517955f,
+1.0562105f,1.05724246f,1.05827542f,1.0593094f,1.06034439f,1.06138039f,1.0624174f,1.06345542f,
+1.06449446f,1.06553451f,1.06657558f,1.06761767f,1.06866077f,1.0697049f,1.07075004f,1.07179621f,
+1.07284339f,1.0738916f,1.07494084f,1.0759911f,1.07704238f,1.0780947f,1.07914804f,1.08020241f,
+1.08125781f,1.08231424f,1.0833717f,1.0844302f,1.08548973f,1.0865503f,1.0876119f,1.08867454f,
+1.08973822f,1.09080293f,1.09186869f,1.09293549f,1.09400333f,1.09507222f,1.09614215f,1.09721312f,
+1.09828514f,1.09935821f,1.10043232f,1.10150749f,1.10258371f,1.10366097f,1.10473929f,1.10581867f,
+1.1068991f,1.10798058f,1.10906312f,1.11014672f,1.11123138f,1.11231709f,1.11340387f,1.11449171f,
+1.11558061f,1.11667058f,1.11776161f,1.11885371f,1.11994687f,1.12104111f,1.12213641f,1.12323278f,
+1.12433022f,1.12542874f,1.12652833f,1.12762899f,1.12873073f,1.12983354f,1.13093743f,1.1320424f,
+1.13314845f,1.13425558f,1.1353638f,1.13647309f,1.13758347f,1.13869493f,1.13980748f,1.14092112f,
+1.14203585f,1.14315166f,1.14426856f,1.14538656f,1.14650565f,1.14762583f,1.14874711f,1.14986948f,
+1.15099294f,1.15211751f,1.15324317f,1.15436994f,1.1554978f,1.15662677f,1.15775684f,1.15888801f,
+1.16002029f,1.16115368f,1.16228817f,1.16342377f,1.16456049f,1.16569831f,1.16683724f,1.16797729f,
+1.16911845f,1.17026072f,1.17140411f,1.17254862f,1.17369425f,1.17484099f,1.17598886f,1.17713785f,
+1.17828796f,1.17943919f,1.18059155f,1.18174503f,1.18289964f,1.18405538f,1.18521225f,1.18637025f,
+1.18752938f,1.18868965f,1.18985104f,1.19101357f,1.19217724f,1.19334205f,1.19450799f,1.19567507f,
+1.19684329f,1.19801265f,1.19918316f,1.20035481f,1.2015276f,1.20270154f,1.20387663f,1.20505287f,
+1.20623025f,1.20740878f,1.20858847f,1.20976931f,1.2109513f,1.21213445f,1.21331875f,1.21450421f,
+1.21569083f,1.21687861f,1.21806755f,1.21925765f,1.22044891f,1.22164134f,1.22283493f,1.22402969f,
+1.22522561f,1.22642271f,1.22762097f,1.2288204f,1.23002101f,1.23122279f,1.23242574f,1.23362987f,
+1.23483518f,1.23604166f,1.23724932f,1.23845816f,1.23966818f,1.24087939f,1.24209178f,1.24330535f,
+1.24452011f,1.24573605f,1.24695319f,1.24817151f,1.24939102f,1.25061173f,1.25183362f,1.25305671f,
+1.254281f,1.25550648f,1.25673316f,1.25796104f,1.25919012f,1.2604204f,1.26165188f,1.26288456f,
+1.26411845f,1.26535354f,1.26658984f,1.26782735f,1.26906607f,1.270306f,1.27154713f,1.27278949f,
+1.27403305f,1.27527783f,1.27652383f,1.27777104f,1.27901948f,1.28026913f,1.28152f,1.2827721f,
+1.28402542f,1.28527996f,1.28653573f,1.28779273f,1.28905095f,1.2903104f,1.29157109f,1.292833f,
+1.29409615f,1.29536054f,1.29662615f,1.29789301f,1.2991611f,1.30043043f,1.30170101f,1.30297282f,
+1.30424587f,1.30552017f,1.30679572f,1.30807251f,1.30935055f,1.31062984f,1.31191037f,1.31319216f,
+1.3144752f,1.3157595f,1.31704505f,1.31833185f,1.31961991f,1.32090923f,1.32219981f,1.32349166f,
+1.32478476f,1.32607913f,1.32737476f,1.32867165f,1.32996982f,1.33126925f,1.33256996f,1.33387193f,
+1.33517517f,1.33647969f,1.33778549f,1.33909256f,1.3404009f,1.34171053f,1.34302143f,1.34433362f,
+1.34564708f,1.34696183f,1.34827787f,1.34959519f,1.3509138f,1.35223369f,1.35355488f,1.35487736f,
+1.35620112f,1.35752619f,1.35885254f,1.3601802f,1.36150915f,1.36283939f,1.36417094f,1.36550379f,
+1.36683794f,1.3681734f,1.36951016f,1.37084822f,1.37218759f,1.37352828f,1.37487027f,1.37621357f,
+1.37755818f,1.37890411f,1.38025136f,1.38159992f,1.38294979f,1.38430099f,1.38565351f,1.38700735f,
+1.38836251f,1.38971899f,1.3910768f,1.39243594f,1.3937964f,1.3951582f,1.39652132f,1.39788578f,
+1.39925157f,1.40061869f,1.40198715f,1.40335695f,1.40472808f,1.40610056f,1.40747438f,1.40884953f,
+1.41022603f,1.41160388f,1.41298307f,1.41436361f,1.4157455f,1.41712874f,1.41851333f,1.41989928f,
+1.42128657f,1.42267523f,1.42406524f,1.42545661f,1.42684933f,1.42824342f,1.42963887f,1.43103569f,
+1.43243386f,1.43383341f,1.43523432f,1.4366366f,1.43804025f,1.43944527f,1.44085167f,1.44225944f,
+1.44366858f,1.4450791f,1.446491f,1.44790428f,1.44931894f,1.45073498f,1.45215241f,1.45357122f,
+1.45499141f,1.456413f,1.45783597f,1.45926034f,1.46068609f,1.46211324f,1.46354178f,1.46497172f,
+1.46640305f,1.46783579f,1.46926992f,1.47070546f,1.47214239f,1.47358073f,1.47502048f,1.47646163f,
+1.4779042f,1.47934817f,1.48079355f,1.48224034f,1.48368855f,1.48513817f,1.48658921f,1.48804167f,
+1.48949554f,1.49095084f,1.49240756f,1.4938657f,1.49532526f,1.49678625f,1.49824867f,1.49971252f,
+1.5011778f,1.50264451f,1.50411265f,1.50558223f,1.50705324f,1.50852569f,1.50999958f,1.51147491f,
+1.51295168f,1.5144299f,1.51590955f,1.51739066f,1.51887321f,1.52035721f,1.52184266f,1.52332956f,
+1.52481791f,1.52630772f,1.52779898f,1.5292917f,1.53078588f,1.53228152f,1.53377862f,1.53527718f,
+1.53677721f,1.5382787f,1.53978166f,1.54128608f,1.54279198f,1.54429935f,1.54580819f,1.54731851f,
+1.5488303f,1.55034357f,1.55185831f,1.55337454f,1.55489225f,1.55641144f,1.55793212f,1.55945428f,
+1.56097793f,1.56250306f,1.56402969f,1.56555781f,1.56708742f,1.56861853f,1.57015113f,1.57168523f,
+1.57322083f,1.57475793f,1.57629653f,1.57783663f,1.57937824f,1.58092135f,1.58246598f,1.58401211f,
+1.58555975f,1.58710891f,1.58865957f,1.59021176f,1.59176546f,1.59332067f,1.59487741f,1.59643567f,
+1.59799545f,1.59955675f,1.60111958f,1.60268394f,1.60424983f,1.60581724f,1.60738619f,1.60895667f,
+1.61052868f,1.61210223f,1.61367732f,1.61525395f,1.61683211f,1.61841182f,1.61999308f,1.62157587f,
+1.62316022f,1.62474611f,1.62633355f,1.62792254f,1.62951309f,1.63110518f,1.63269884f,1.63429405f,
+1.63589082f,1.63748915f,1.63908904f,1.6406905f,1.64229352f,1.6438981f,1.64550425f,1.64711198f,
+1.64872127f,1.65033214f,1.65194458f,1.65355859f,1.65517418f,1.65679135f,1.6584101f,1.66003044f,
+1.66165235f,1.66327585f,1.66490094f,1.66652761f,1.66815588f,1.66978573f,1.67141718f,1.67305022f,
+1.67468485f,1.67632109f,1.67795892f,1.67959835f,1.68123938f,1.68288202f,1.68452626f,1.68617211f,
+1.68781957f,1.68946864f,1.69111931f,1.6927716f,1.69442551f,1.69608103f,1.69773817f,1.69939692f,
+1.7010573f,1.7027193f,1.70438293f,1.70604818f,1.70771505f,1.70938356f,1.71105369f,1.71272546f,
+1.71439886f,1.7160739f,1.71775057f,1.71942888f,1.72110883f,1.72279042f,1.72447365f,1.72615853f,
+1.72784506f,1.72953323f,1.73122305f,1.73291452f,1.73460765f,1.73630243f,1.73799887f,1.73969696f,
+1.74139671f,1.74309813f,1.7448012f,1.74650594f,1.74821235f,1.74992042f,1.75163016f,1.75334157f,
+1.75505466f,1.75676941f,1.75848585f,1.76020396f,1.76192375f,1.76364522f,1.76536837f,1.7670932f,
+1.76881972f,1.77054793f,1.77227782f,1.77400941f,1.77574269f,1.77747766f,1.77921432f,1.78095269f,
+1.78269275f,1.78443451f,1.78617797f,1.78792314f,1.78967001f,1.79141859f,1.79316887f,1.79492087f,
+1.79667458f,1.79843f,1.80018714f,1.80194599f,1.80370656f,1.80546886f,1.80723287f,1.80899861f,
+1.81076607f,1.81253526f,1.81430618f,1.81607883f,1.81785321f,1.81962932f,1.82140717f,1.82318676f,
+1.82496809f,1.82675115f,1.82853596f,1.83032251f,1.83211081f,1.83390085f,1.83569265f,1.83748619f,
+1.83928149f,1.84107854f,1.84287735f,1.84467791f,1.84648023f,1.84828432f,1.85009016f,1.85189777f,
+1.85370715f,1.8555183f,1.85733121f,1.8591459f,1.86096236f,1.86278059f,1.8646006f,1.86642239f,
+1.86824596f,1.87007131f,1.87189844f,1.87372736f,1.87555807f,1.87739056f,1.87922484f,1.88106092f,
+1.88289879f,1.88473846f,1.88657992f,1.88842319f,1.89026825f,1.89211512f,1.89396379f,1.89581426f,
+1.89766655f,1.89952065f,1.90137655f,1.90323427f,1.90509381f,1.90695516f,1.90881833f,1.91068332f,
+1.91255013f,1.91441877f,1.91628923f,1.91816152f,1.92003564f,1.92191159f,1.92378938f,1.925669f,
+1.92755045f,1.92943374f,1.93131888f,1.93320585f,1.93509467f,1.93698533f,1.93887784f,1.9407722f,
+1.94266842f,1.94456648f,1.9464664f,1.94836817f,1.9502718f,1.9521773f,1.95408465f,1.95599387f,
+1.95790495f,1.9598179f,1.96173272f,1.96364941f,1.96556798f,1.96748841f,1.96941073f,1.97133492f,
+1.97326099f,1.97518895f,1.97711878f,1.97905051f,1.98098412f,1.98291962f,1.98485701f,1.98679629f,
+1.98873747f,1.99068054f,1.99262552f,1.99457239f,1.99652117f,1.99847185f,2.00042443f,2.00237893f,
+2.00433533f,2.00629365f,2.00825387f,2.01021602f,2.01218008f,2.01414606f,2.01611396f,2.01808378f,
+2.02005553f,2.0220292f,2.0240048f,2.02598234f,2.0279618f,2.0299432f,2.03192653f,2.03391181f,
+2.03589902f,2.03788817f,2.03987927f,2.04187231f,2.0438673f,2.04586424f,2.04786313f,2.04986398f,
+2.05186677f,2.05387153f,2.05587824f,2.05788692f,2.05989755f,2.06191015f,2.06392472f,2.06594126f,
+2.06795976f,2.06998024f,2.07200269f,2.07402712f,2.07605353f,2.07808192f,2.08011228f,2.08214464f,
+2.08417897f,2.0862153f,2.08825361f,2.09029392f,2.09233622f,2.09438051f,2.09642681f,2.0984751f,
+2.10052539f,2.10257769f,2.10463199f,2.1066883f,2.10874662f,2.11080694f,2.11286929f,2.11493364f,
+2.11700002f,2.11906841f,2.12113882f,2.12321126f,2.12528572f,2.12736221f,2.12944073f,2.13152127f,
+2.13360385f,2.13568847f,2.13777512f,2.13986381f,2.14195454f,2.14404732f,2.14614214f,2.148239f,
+2.15033792f,2.15243888f,2.1545419f,2.15664697f,2.1587541f,2.16086329f,2.16297454f,2.16508785f,
+2.16720323f,2.16932067f,2.17144018f,2.17356176f,2.17568542f,2.17781115f,2.17993896f,2.18206884f,
+2.18420081f,2.18633486f,2.188471f,2.19060922f,2.19274953f,2.19489193f,2.19703643f,2.19918302f,
+2.20133171f,2.2034825f,2.20563539f,2.20779038f,2.20994748f,2.21210668f,2.214268f,2.21643143f,
+2.21859697f,2.22076463f,2.2229344f,2.22510629f,2.22728031f,2.22945645f,2.23163472f,2.23381511f,
+2.23599764f,2.2381823f,2.24036909f,2.24255802f,2.24474909f,2.2469423f,2.24913765f,2.25133514f,
+2.25353479f,2.25573658f,2.25794052f,2.26014662f,2.26235487f,2.26456528f,2.26677785f,2.26899258f,
+2.27120948f,2.27342854f,2.27564977f,2.27787317f,2.28009874f,2.28232649f,2.28455641f,2.28678851f,
+2.2890228f,2.29125926f,2.29349791f,2.29573875f,2.29798178f,2.300227f,2.30247441f,2.30472402f,
+2.30697582f,2.30922983f,2.31148604f,2.31374445f,2.31600507f,2.3182679f,2.32053294f,2.32280019f,
+2.32506966f,2.32734135f,2.32961525f,2.33189138f,2.33416973f,2.3364503f,2.33873311f,2.34101814f,
+2.34330541f,2.34559491f,2.34788665f,2.35018063f,2.35247685f,2.35477531f,2.35707602f,2.35937897f,
+2.36168418f,2.36399164f,2.36630135f,2.36861332f,2.37092755f,2.37324404f,2.37556279f,2.37788381f,
+2.3802071f,2.38253265f,2.38486048f,2.38719059f,2.38952297f,2.39185762f,2.39419456f,2.39653379f,
+2.39887529f,2.40121909f,2.40356518f,2.40591355f,2.40826423f,2.4106172f,2.41297246f,2.41533003f,
+2.41768991f,2.42005208f,2.42241657f,2.42478337f,2.42715248f,2.4295239f,2.43189764f,2.4342737f,
+2.43665208f,2.43903279f,2.44141582f,2.44380118f,2.44618887f,2.44857889f,2.45097125f,2.45336595f,
+2.45576298f,2.45816236f,2.46056408f,2.46296815f,2.46537457f,2.46778334f,2.47019446f,2.47260793f,
+2.47502377f,2.47744197f,2.47986252f,2.48228545f,2.48471074f,2.4871384f,2.48956843f,2.49200084f,
+2.49443562f,2.49687278f,2.49931233f,2.50175425f,2.50419857f,2.50664527f,2.50909436f,2.51154584f,
+2.51399972f,2.516456f,2.51891468f,2.52137576f,2.52383924f,2.52630513f,2.52877343f,2.53124414f,
+2.53371727f,2.53619281f,2.53867077f,2.54115115f,2.54363396f,2.54611919f,2.54860685f,2.55109694f,
+2.55358946f,2.55608442f,2.55858181f,2.56108165f,2.56358392f,2.56608865f,2.56859582f,2.57110544f,
+2.57361751f,2.57613203f,2.57864902f,2.58116846f,2.58369036f,2.58621473f,2.58874156f,2.59127087f,
+2.59380264f,2.59633689f,2.59887361f,2.60141281f,2.6039545f,2.60649866f,2.60904532f,2.61159446f,
+2.61414609f,2.61670021f,2.61925683f,2.62181595f,2.62437757f,2.62694169f,2.62950831f,2.63207745f,
+2.63464909f,2.63722325f,2.63979992f,2.64237911f,2.64496081f,2.64754504f,2.6501318f,2.65272108f,
+2.6553129f,2.65790724f,2.66050412f,2.66310354f,2.6657055f,2.66831f,2.67091704f,2.67352663f,
+2.67613877f,2.67875347f,2.68137072f,2.68399052f,2.68661289f,2.68923781f,2.6918653f,2.69449536f,
+2.69712799f,2.69976319f,2.70240097f,2.70504132f,2.70768425f,2.71032977f,2.71297787f,2.71562855f,
+};
+
+float svfreq_map_table[128] = {
+0.0f,0.000794173103f,0.00161461995f,0.00246199245f,0.0033369569f,0.00424019426f,0.00517240049f,0.0061342868f,
+0.00712658006f,0.008150023f,0.00920537465f,0.0102934106f,0.0114149234f,0.0125707229f,0.0137616364f,0.0149885095f,
+0.0162522059f,0.0175536081f,0.0188936178f,0.0202731561f,0.0216931642f,0.0231546034f,0.0246584558f,0.0262057247f,
+0.0277974351f,0.0294346337f,0.0311183899f,0.0328497961f,0.0346299679f,0.0364600449f,0.0383411911f,0.0402745951f,
+0.0422614712f,0.0443030593f,0.0464006258f,0.0485554641f,0.0507688948f,0.0530422669f,0.0553769577f,0.0577743738f,
+0.0602359516f,0.0627631576f,0.0653574896f,0.0680204767f,0.0707536805f,0.0735586952f,0.0764371488f,0.0793907032f,
+0.0824210556f,0.0855299383f,0.0887191203f,0.0919904075f,0.0953456434f,0.0987867104f,0.10231553f,0.105934063f,
+0.109644313f,0.113448324f,0.117348182f,0.121346018f,0.125444005f,0.129644363f,0.133949359f,0.138361303f,
+0.142882556f,0.147515528f,0.152262676f,0.157126512f,0.162109596f,0.167214543f,0.17244402f,0.177800751f,
+0.183287515f,0.188907148f,0.194662544f,0.200556657f,0.206592502f,0.212773154f,0.219101753f,0.225581503f,
+0.232215671f,0.239007594f,0.245960676f,0.253078389f,0.260364278f,0.267821959f,0.275455122f,0.283267531f,
+0.291263028f,0.299445533f,0.307819044f,0.316387643f,0.32515549f,0.334126835f,0.343306009f,0.352697435f,
+0.362305621f,0.372135171f,0.382190777f,0.39247723f,0.402999414f,0.413762314f,0.424771015f,0.436030703f,
+0.447546669f,0.459324312f,0.471369136f,0.48368676f,0.496282911f,0.509163434f,0.522334291f,0.535801563f,
+0.54957145f,0.563650281f,0.578044509f,0.592760714f,0.607805612f,0.623186048f,0.638909008f,0.654981614f,
+0.671411132f,0.688204972f,0.705370691f,0.722915996f,0.740848749f,0.759176968f,0.777908828f,0.797052667f,
+};
+
+int16_t svfreq_map_table_q15[128] = {
+0,26,52,80,109,138,169,201,
+233,267,301,337,374,411,450,491,
+532,575,619,664,710,758,808,858,
+910,964,1019,1076,1134,1194,1256,1319,
+1384,1451,1520,1591,1663,1738,1814,1893,
+1973,2056,2141,2228,2318,2410,2504,2601,
+2700,2802,2907,3014,3124,3237,3352,3471,
+3592,3717,3845,3976,4110,4248,4389,4533,
+4681,4833,4989,5148,5312,5479,5650,5826,
+6005,6190,6378,6571,6769,6972,7179,7391,
+7609,7831,8059,8292,8531,8775,9026,9282,
+9544,9812,10086,10367,10654,10948,11249,11557,
+11872,12194,12523,12860,13205,13558,13918,14287,
+14665,15051,15445,15849,16262,16684,17115,17557,
+18008,18469,18941,19423,19916,20420,20935,21462,
+22000,22551,23113,23688,24276,24876,25490,26117,
+};
+
+float svfreq_fine_table[257] = {
+0.0f,0.000393842525f,0.000794173103f,0.0012010719f,0.00161461995f,0.00203489919f,0.00246199245f,0.00289598347f,
+0.0033369569f,0.00378499832f,0.00424019426f,0.00470263218f,0.00517240049f,0.00564958858f,0.0061342868f,0.00662658652f,
+0.00712658006f,0.00763436076f,0.008150023f,0.00867366216f,0.00920537465f,0.00974525797f,0.0102934106f,0.0108499322f,
+0.0114149234f,0.011988486f,0.0125707229f,0.013161738f,0.0137616364f,0.0143705245f,0.0149885095f,0.0156157f,
+0.0162522059f,0.0168981378f,0.0175536081f,0.0182187299f,0.0188936178f,0.0195783875f,0.0202731561f,0.0209780418f,
+0.0216931642f,0.022418644f,0.0231546034f,0.0239011657f,0.0246584558f,0.0254265996f,0.0262057247f,0.0269959598f,
+0.0277974351f,0.028610282f,0.0294346337f,0.0302706244f,0.0311183899f,0.0319780676f,0.0328497961f,0.0337337157f,
+0.0346299679f,0.0355386961f,0.0364600449f,0.0373941607f,0.0383411911f,0.0393012856f,0.0402745951f,0.0412612723f,
+0.0422614712f,0.0432753477f,0.0443030593f,0.0453447651f,0.0464006258f,0.0474708041f,0.0485554641f,0.0496547717f,
+0.0507688948f,0.0518980028f,0.0530422669f,0.0542018603f,0.0553769577f,0.0565677361f,0.0577743738f,0.0589970516f,
+0.0602359516f,0.0614912582f,0.0627631576f,0.064051838f,0.0653574896f,0.0666803044f,0.0680204767f,0.0693782026f,
+0.0707536805f,0.0721471105f,0.0735586952f,0.0749886391f,0.0764371488f,0.0779044332f,0.0793907032f,0.0808961722f,
+0.0824210556f,0.0839655709f,0.0855299383f,0.0871143799f,0.0887191203f,0.0903443864f,0.0919904075f,0.0936574151f,
+0.0953456434f,0.0970553289f,0.0987867104f,0.100540029f,0.10231553f,0.104113458f,0.105934063f,0.107777597f,
+0.109644313f,0.111534469f,0.113448324f,0.11538614f,0.117348182f,0.119334718f,0.121346018f,0.123382355f,
+0.125444005f,0.127531247f,0.129644363f,0.131783638f,0.133949359f,0.136141816f,0.138361303f,0.140608116f,
+0.142882556f,0.145184924f,0.147515528f,0.149874674f,0.152262676f,0.15467985f,0.157126512f,0.159602986f,
+0.162109596f,0.164646671f,0.167214543f,0.169813546f,0.17244402f,0.175106307f,0.177800751f,0.180527703f,
+0.183287515f,0.186080543f,0.188907148f,0.191767692f,0.194662544f,0.197592074f,0.200556657f,0.203556672f,
+0.206592502f,0.209664532f,0.212773154f,0.215918762f,0.219101753f,0.222322531f,0.225581503f,0.228879078f,
+0.232215671f,0.235591702f,0.239007594f,0.242463775f,0.245960676f,0.249498734f,0.253078389f,0.256700088f,
+0.260364278f,0.264071416f,0.267821959f,0.271616372f,0.275455122f,0.279338682f,0.283267531f,0.287242151f,
+0.291263028f,0.295330657f,0.299445533f,0.30360816f,0.307819044f,0.312078699f,0.316387643f,0.320746397f,
+0.32515549f,0.329615456f,0.334126835f,0.338690169f,0.343306009f,0.347974911f,0.352697435f,0.357474147f,
+0.362305621f,0.367192435f,0.372135171f,0.37713442f,0.382190777f,0.387304845f,0.39247723f,0.397708546f,
+0.402999414f,0.408350459f,0.413762314f,0.419235618f,0.424771015f,0.430369157f,0.436030703f,0.441756316f,
+0.447546669f,0.453402439f,0.459324312f,0.465312978f,0.471369136f,0.477493493f,0.48368676f,0.489949657f,
+0.496282911f,0.502687256f,0.509163434f,0.515712194f,0.522334291f,0.52903049f,0.535801563f,0.542648287f,
+0.54957145f,0.556571848f,0.563650281f,0.570807562f,0.578044509f,0.585361948f,0.592760714f,0.600241652f,
+0.607805612f,0.615453454f,0.623186048f,0.631004271f,0.638909008f,0.646901154f,0.654981614f,0.663151299f,
+0.671411132f,0.679762043f,0.688204972f,0.696740868f,0.705370691f,0.714095407f,0.722915996f,0.731833444f,
+0.740848749f,0.749962918f,0.759176968f,0.768491925f,0.777908828f,0.787428722f,0.797052667f,0.806781731f,
+0.816616991f,
+};
+
+const uint32_t note_table[128] = {
+0,775058,821146,869974,921705,976512,1034579,1096098,
+1161276,1230329,1303488,1380997,1463116,1550117,1642292,1739948,
+1843410,1953025,2069158,2192197,2322552,2460658,2606976,2761995,
+2926232,3100235,3284584,3479896,3686821,3906051,4138317,4384394,
+4645104,4921316,5213953,5523991,5852464,6200470,6569169,6959792,
+7373643,7812103,8276635,8768789,9290208,9842633,10427906,11047982,
+11704929,12400940,13138339,13919585,14747287,15624206,16553270,17537578,
+18580417,19685266,20855813,22095964,23409859,24801881,26276678,27839171,
+29494574,31248413,33106540,35075157,37160835,39370533,41711627,44191929,
+46819718,49603763,52553357,55678342,58989149,62496826,66213081,70150315,
+74321670,78741067,83423254,88383859,93639437,99207527,105106714,111356684,
+117978298,124993652,132426162,140300631,148643341,157482134,166846509,176767718,
+187278874,198415055,210213428,222713369,235956596,249987305,264852324,280601262,
+297286682,314964268,333693018,353535437,374557748,396830111,420426857,445426739,
+471913192,499974610,529704648,561202525,594573364,629928536,667386036,707070875,
+749115497,793660223,840853715,890853479,943826384,999949221,1059409296,1122405051,
+};
+
+const uint32_t cents_table[100] = {
+2147483648,2148724441,2149965951,2151208179,2152451125,2153694788,2154939171,2156184272,
+2157430093,2158676633,2159923894,2161171875,2162420578,2163670001,2164920147,2166171015,
+2167422606,2168674920,2169927958,2171181720,2172436206,2173691416,2174947352,2176204014,
+2177461402,2178719516,2179978358,2181237926,2182498223,2183759247,2185021000,2186283483,
+2187546694,2188810636,2190075308,2191340710,2192606844,2193873709,2195141306,2196409636,
+2197678698,2198948494,2200219023,2201490287,2202762285,2204035018,2205308486,2206582690,
+2207857631,2209133307,2210409722,2211686873,2212964763,2214243390,2215522757,2216802863,
+2218083708,2219365294,2220647620,2221930687,2223214495,2224499045,2225784337,2227070372,
+2228357150,2229644671,2230932936,2232221946,2233511700,2234802200,2236093445,2237385437,
+2238678175,2239971659,2241265891,2242560871,2243856599,2245153076,2246450302,2247748278,
+2249047003,2250346479,2251646705,2252947683,2254249413,2255551894,2256855128,2258159116,
+2259463856,2260769351,2262075600,2263382603,2264690362,2265998876,2267308147,2268618173,
+2269928957,2271240498,2272552797,2273865854,
+};
+
+int16_t grain_window_table[257] = {
+0,4,19,44,78,123,177,241,
+314,398,491,593,705,826,957,1097,
+1247,1405,1573,1749,1934,2128,2330,2541,
+2761,2988,3224,3467,3718,3977,4244,4517,
+4798,5086,5381,5682,5990,6304,6624,6949,
+7281,7618,7960,8308,8660,9017,9378,9744,
+10114,10487,10864,11244,11627,12014,12403,12794,
+13187,13582,13979,14378,14778,15178,15580,15981,
+16383,16786,17187,17589,17989,18389,18788,19185,
+19580,19973,20364,20753,21140,21523,21903,22280,
+22653,23023,23389,23750,24107,24459,24807,25149,
+25486,25818,26143,26463,26777,27085,27386,27681,
+27969,28250,28523,28790,29049,29300,29543,29779,
+30006,30226,30437,30639,30833,31018,31194,31362,
+31520,31670,31810,31941,32062,32174,32276,32369,
+32453,32526,32590,32644,32689,32723,32748,32763,
+32767,32763,32748,32723,32689,32644,32590,32526,
+32453,32369,32276,32174,32062,31941,31810,31670,
+31520,31362,31194,31018,30833,30639,30437,30226,
+30006,29779,29543,29300,29049,28790,28523,28250,
+27969,27681,27386,27085,26777,26463,26143,25818,
+25486,25149,24807,24459,24107,23750,23389,23023,
+22653,22280,21903,21523,21140,20753,20364,19973,
+19580,19185,18788,18389,17989,17589,17187,16786,
+16384,15981,15580,15178,14778,14378,13979,13582,
+13187,12794,12403,12014,11627,11244,10864,10487,
+10114,9744,9378,9017,8660,8308,7960,7618,
+7281,6949,6624,6304,5990,5682,5381,5086,
+4798,4517,4244,3977,3718,3467,3224,2988,
+2761,2541,2330,2128,1934,1749,1573,1405,
+1247,1097,957,826,705,593,491,398,
+314,241,177,123,78,44,19,4,
+0,
+};
+
+int16_t fm_sine_table[4096] = {
+0,100,201,301,402,502,603,703,
+804,904,1005,1105,1206,1306,1407,1507,
+1607,1708,1808,1909,2009,2109,2210,2310,
+2410,2510,2611,2711,2811,2911,3011,3111,
+3211,3311,3411,3511,3611,3711,3811,3911,
+4011,4110,4210,4310,4409,4509,4609,4708,
+4808,4907,5006,5106,5205,5304,5403,5503,
+5602,5701,5800,5898,5997,6096,6195,6294,
+6392,6491,6589,6688,6786,6884,6983,7081,
+7179,7277,7375,7473,7571,7669,7766,7864,
+7961,8059,8156,8254,8351,8448,8545,8642,
+8739,8836,8933,9029,9126,9223,9319,9415,
+9512,9608,9704,9800,9896,9991,10087,10183,
+10278,10374,10469,10564,10659,10754,10849,10944,
+11039,11133,11228,11322,11416,11511,11605,11699,
+11793,11886,11980,12073,12167,12260,12353,12446,
+12539,12632,12725,12817,12910,13002,13094,13186,
+13278,13370,13462,13554,13645,13736,13828,13919,
+14010,14100,14191,14282,14372,14462,14552,14642,
+14732,14822,14912,15001,15090,15180,15269,15357,
+15446,15535,15623,15712,15800,15888,15976,16063,
+16151,16238,16325,16413,16499,16586,16673,16759,
+16846,16932,17018,17104,17189,17275,17360,17445,
+17530,17615,17700,17784,17869,17953,18037,18121,
+18204,18288,18371,18454,18537,18620,18703,18785,
+18868,18950,19032,19113,19195,19276,19358,19439,
+19519,19600,19681,19761,19841,19921,20001,20080,
+20159,20239,20318,20396,20475,20553,20631,20709,
+20787,20865,20942,21020,21097,21173,21250,21326,
+21403,21479,21555,21630,21706,21781,21856,21931,
+22005,22080,22154,22228,22301,22375,22448,22521,
+22594,22667,22740,22812,22884,22956,23027,23099,
+23170,23241,23312,23382,23453,23523,23593,23662,
+23732,23801,23870,23939,24007,24075,24144,24211,
+24279,24346,24414,24480,24547,24614,24680,24746,
+24812,24877,24943,25008,25073,25137,25201,25266,
+25330,25393,25457,25520,25583,25645,25708,25770,
+25832,25894,25955,26016,26077,26138,26199,26259,
+26319,26379,26438,26498,26557,26615,26674,26732,
+26790,26848,26905,26963,27020,27076,27133,27189,
+27245,27301,27356,27411,27466,27521,27576,27630,
+27684,27737,27791,27844,27897,27949,28002,28054,
+28106,28157,28208,28259,28310,28361,28411,28461,
+28511,28560,28609,28658,28707,28755,28803,28851,
+28898,28946,28993,29039,29086,29132,29178,29223,
+29269,29314,29359,29403,29447,29491,29535,29578,
+29621,29664,29707,29749,29791,29833,29874,29915,
+29956,29997,30037,30077,30117,30156,30196,30235,
+30273,30312,30350,30387,30425,30462,30499,30535,
+30572,30608,30644,30679,30714,30749,30784,30818,
+30852,30886,30919,30952,30985,31018,31050,31082,
+31114,31145,31176,31207,31237,31268,31298,31327,
+31357,31386,31414,31443,31471,31499,31526,31554,
+31581,31607,31634,31660,31685,31711,31736,31761,
+31785,31810,31834,31857,31881,31904,31927,31949,
+31971,31993,32015,32036,32057,32078,32098,32118,
+32138,32157,32176,32195,32214,32232,32250,32268,
+32285,32302,32319,32335,32351,32367,32383,32398,
+32413,32427,32442,32456,32469,32483,32496,32509,
+32521,32533,32545,32557,32568,32579,32589,32600,
+32610,32619,32629,32638,32647,32655,32663,32671,
+32679,32686,32693,32700,32706,32712,32718,32723,
+32728,32733,32737,32741,32745,32749,32752,32755,
+32758,32760,32762,32764,32765,32766,32767,32767,
+32767,32767,32767,32766,32765,32764,32762,32760,
+32758,32755,32752,32749,32745,32741,32737,32733,
+32728,32723,32718,32712,32706,32700,32693,32686,
+32679,32671,32663,32655,32647,32638,32629,32619,
+32610,32600,32589,32579,32568,32557,32545,32533,
+32521,32509,32496,32483,32469,32456,32442,32427,
+32413,32398,32383,32367,32351,32335,32319,32302,
+32285,32268,32250,32232,32214,32195,32176,32157,
+32138,32118,32098,32078,32057,32036,32015,31993,
+31971,31949,31927,31904,31881,31857,31834,31810,
+31785,31761,31736,31711,31685,31660,31634,31607,
+31581,31554,31526,31499,31471,31443,31414,31386,
+31357,31327,31298,31268,31237,31207,31176,31145,
+31114,31082,31050,31018,30985,30952,30919,30886,
+30852,30818,30784,30749,30714,30679,30644,30608,
+30572,30535,30499,30462,30425,30387,30350,30312,
+30273,30235,30196,30156,30117,30077,30037,29997,
+29956,29915,29874,29833,29791,29749,29707,29664,
+29621,29578,29535,29491,29447,29403,29359,29314,
+29269,29223,29178,29132,29086,29039,28993,28946,
+28898,28851,28803,28755,28707,28658,28609,28560,
+28511,28461,28411,28361,28310,28259,28208,28157,
+28106,28054,28002,27949,27897,27844,27791,27737,
+27684,27630,27576,27521,27466,27411,27356,27301,
+27245,27189,27133,27076,27020,26963,26905,26848,
+26790,26732,26674,26615,26557,26498,26438,26379,
+26319,26259,26199,26138,26077,26016,25955,25894,
+25832,25770,25708,25645,25583,25520,25457,25393,
+25330,25266,25201,25137,25073,25008,24943,24877,
+24812,24746,24680,24614,24547,24480,24414,24346,
+24279,24211,24144,24075,24007,23939,23870,23801,
+23732,23662,23593,23523,23453,23382,23312,23241,
+23170,23099,23027,22956,22884,22812,22740,22667,
+22594,22521,22448,22375,22301,22228,22154,22080,
+22005,21931,21856,21781,21706,21630,21555,21479,
+21403,21326,21250,21173,21097,21020,20942,20865,
+20787,20709,20631,20553,20475,20396,20318,20239,
+20159,20080,20001,19921,19841,19761,19681,19600,
+19519,19439,19358,19276,19195,19113,19032,18950,
+18868,18785,18703,18620,18537,18454,18371,18288,
+18204,18121,18037,17953,17869,17784,17700,17615,
+17530,17445,17360,17275,17189,17104,17018,16932,
+16846,16759,16673,16586,16499,16413,16325,16238,
+16151,16063,15976,15888,15800,15712,15623,15535,
+15446,15357,15269,15180,15090,15001,14912,14822,
+14732,14642,14552,14462,14372,14282,14191,14100,
+14010,13919,13828,13736,13645,13554,13462,13370,
+13278,13186,13094,13002,12910,12817,12725,12632,
+12539,12446,12353,12260,12167,12073,11980,11886,
+11793,11699,11605,11511,11416,11322,11228,11133,
+11039,10944,10849,10754,10659,10564,10469,10374,
+10278,10183,10087,9991,9896,9800,9704,9608,
+9512,9415,9319,9223,9126,9029,8933,8836,
+8739,8642,8545,8448,8351,8254,8156,8059,
+7961,7864,7766,7669,7571,7473,7375,7277,
+7179,7081,6983,6884,6786,6688,6589,6491,
+6392,6294,6195,6096,5997,5898,5800,5701,
+5602,5503,5403,5304,5205,5106,5006,4907,
+4808,4708,4609,4509,4409,4310,4210,4110,
+4011,3911,3811,3711,3611,3511,3411,3311,
+3211,3111,3011,2911,2811,2711,2611,2510,
+2410,2310,2210,2109,2009,1909,1808,1708,
+1607,1507,1407,1306,1206,1105,1005,904,
+804,703,603,502,402,301,201,100,
+0,-100,-201,-301,-402,-502,-603,-703,
+-804,-904,-1005,-1105,-1206,-1306,-1407,-1507,
+-1607,-1708,-1808,-1909,-2009,-2109,-2210,-2310,
+-2410,-2510,-2611,-2711,-2811,-2911,-3011,-3111,
+-3211,-3311,-3411,-3511,-3611,-3711,-3811,-3911,
+-4011,-4110,-4210,-4310,-4409,-4509,-4609,-4708,
+-4808,-4907,-5006,-5106,-5205,-5304,-5403,-5503,
+-5602,-5701,-5800,-5898,-5997,-6096,-6195,-6294,
+-6392,-6491,-6589,-6688,-6786,-6884,-6983,-7081,
+-7179,-7277,-7375,-7473,-7571,-7669,-7766,-7864,
+-7961,-8059,-8156,-8254,-8351,-8448,-8545,-8642,
+-8739,-8836,-8933,-9029,-9126,-9223,-9319,-9415,
+-9512,-9608,-9704,-9800,-9896,-9991,-10087,-10183,
+-10278,-10374,-10469,-10564,-10659,-10754,-10849,-10944,
+-11039,-11133,-11228,-11322,-11416,-11511,-11605,-11699,
+-11793,-11886,-11980,-12073,-12167,-12260,-12353,-12446,
+-12539,-12632,-12725,-12817,-12910,-13002,-13094,-13186,
+-13278,-13370,-13462,-13554,-13645,-13736,-13828,-13919,
+-14010,-14100,-14191,-14282,-14372,-14462,-14552,-14642,
+-14732,-14822,-14912,-15001,-15090,-15180,-15269,-15357,
+-15446,-15535,-15623,-15712,-15800,-15888,-15976,-16063,
+-16151,-16238,-16325,-16413,-16499,-16586,-16673,-16759,
+-16846,-16932,-17018,-17104,-17189,-17275,-17360,-17445,
+-17530,-17615,-17700,-17784,-17869,-17953,-18037,-18121,
+-18204,-18288,-18371,-18454,-18537,-18620,-18703,-18785,
+-18868,-18950,-19032,-19113,-19195,-19276,-19358,-19439,
+-19519,-19600,-19681,-19761,-19841,-19921,-20001,-20080,
+-20159,-20239,-20318,-20396,-20475,-20553,-20631,-20709,
+-20787,-20865,-20942,-21020,-21097,-21173,-21250,-21326,
+-21403,-21479,-21555,-21630,-21706,-21781,-21856,-21931,
+-22005,-22080,-22154,-22228,-22301,-22375,-22448,-22521,
+-22594,-22667,-22740,-22812,-22884,-22956,-23027,-23099,
+-23170,-23241,-23312,-23382,-23453,-23523,-23593,-23662,
+-23732,-23801,-23870,-23939,-24007,-24075,-24144,-24211,
+-24279,-24346,-24414,-24480,-24547,-24614,-24680,-24746,
+-24812,-24877,-24943,-25008,-25073,-25137,-25201,-25266,
+-25330,-25393,-25457,-25520,-25583,-25645,-25708,-25770,
+-25832,-25894,-25955,-26016,-26077,-26138,-26199,-26259,
+-26319,-26379,-26438,-26498,-26557,-26615,-26674,-26732,
+-26790,-26848,-26905,-26963,-27020,-27076,-27133,-27189,
+-27245,-27301,-27356,-27411,-27466,-27521,-27576,-27630,
+-27684,-27737,-27791,-27844,-27897,-27949,-28002,-28054,
+-28106,-28157,-28208,-28259,-28310,-28361,-28411,-28461,
+-28511,-28560,-28609,-28658,-28707,-28755,-28803,-28851,
+-28898,-28946,-28993,-29039,-29086,-29132,-29178,-29223,
+-29269,-29314,-29359,-29403,-29447,-29491,-29535,-29578,
+-29621,-29664,-29707,-29749,-29791,-29833,-29874,-29915,
+-29956,-29997,-30037,-30077,-30117,-30156,-30196,-30235,
+-30273,-30312,-30350,-30387,-30425,-30462,-30499,-30535,
+-30572,-30608,-30644,-30679,-30714,-30749,-30784,-30818,
+-30852,-30886,-30919,-30952,-30985,-31018,-31050,-31082,
+-31114,-31145,-31176,-31207,-31237,-31268,-31298,-31327,
+-31357,-31386,-31414,-31443,-31471,-31499,-31526,-31554,
+-31581,-31607,-31634,-31660,-31685,-31711,-31736,-31761,
+-31785,-31810,-31834,-31857,-31881,-31904,-31927,-31949,
+-31971,-31993,-32015,-32036,-32057,-32078,-32098,-32118,
+-32138,-32157,-32176,-32195,-32214,-32232,-32250,-32268,
+-32285,-32302,-32319,-32335,-32351,-32367,-32383,-32398,
+-32413,-32427,-32442,-32456,-32469,-32483,-32496,-32509,
+-32521,-32533,-32545,-32557,-32568,-32579,-32589,-32600,
+-32610,-32619,-32629,-32638,-32647,-32655,-32663,-32671,
+-32679,-32686,-32693,-32700,-32706,-32712,-32718,-32723,
+-32728,-32733,-32737,-32741,-32745,-32749,-32752,-32755,
+-32758,-32760,-32762,-32764,-32765,-32766,-32767,-32767,
+-32768,-32767,-32767,-32766,-32765,-32764,-32762,-32760,
+-32758,-32755,-32752,-32749,-32745,-32741,-32737,-32733,
+-32728,-32723,-32718,-32712,-32706,-32700,-32693,-32686,
+-32679,-32671,-32663,-32655,-32647,-32638,-32629,-32619,
+-32610,-32600,-32589,-32579,-32568,-32557,-32545,-32533,
+-32521,-32509,-32496,-32483,-32469,-32456,-32442,-32427,
+-32413,-32398,-32383,-32367,-32351,-32335,-32319,-32302,
+-32285,-32268,-32250,-32232,-32214,-32195,-32176,-32157,
+-32138,-32118,-32098,-32078,-32057,-32036,-32015,-31993,
+-31971,-31949,-31927,-31904,-31881,-31857,-31834,-31810,
+-31785,-31761,-31736,-31711,-31685,-31660,-31634,-31607,
+-31581,-31554,-31526,-31499,-31471,-31443,-31414,-31386,
+-31357,-31327,-31298,-31268,-31237,-31207,-31176,-31145,
+-31114,-31082,-31050,-31018,-30985,-30952,-30919,-30886,
+-30852,-30818,-30784,-30749,-30714,-30679,-30644,-30608,
+-30572,-30535,-30499,-30462,-30425,-30387,-30350,-30312,
+-30273,-30235,-30196,-30156,-30117,-30077,-30037,-29997,
+-29956,-29915,-29874,-29833,-29791,-29749,-29707,-29664,
+-29621,-29578,-29535,-29491,-29447,-29403,-29359,-29314,
+-29269,-29223,-29178,-29132,-29086,-29039,-28993,-28946,
+-28898,-28851,-28803,-28755,-28707,-28658,-28609,-28560,
+-28511,-28461,-28411,-28361,-28310,-28259,-28208,-28157,
+-28106,-28054,-28002,-27949,-27897,-27844,-27791,-27737,
+-27684,-27630,-27576,-27521,-27466,-27411,-27356,-27301,
+-27245,-27189,-27133,-27076,-27020,-26963,-26905,-26848,
+-26790,-26732,-26674,-26615,-26557,-26498,-26438,-26379,
+-26319,-26259,-26199,-26138,-26077,-26016,-25955,-25894,
+-25832,-25770,-25708,-25645,-25583,-25520,-25457,-25393,
+-25330,-25266,-25201,-25137,-25073,-25008,-24943,-24877,
+-24812,-24746,-24680,-24614,-24547,-24480,-24414,-24346,
+-24279,-24211,-24144,-24075,-24007,-23939,-23870,-23801,
+-23732,-23662,-23593,-23523,-23453,-23382,-23312,-23241,
+-23170,-23099,-23027,-22956,-22884,-22812,-22740,-22667,
+-22594,-22521,-22448,-22375,-22301,-22228,-22154,-22080,
+-22005,-21931,-21856,-21781,-21706,-21630,-21555,-21479,
+-21403,-21326,-21250,-21173,-21097,-21020,-20942,-20865,
+-20787,-20709,-20631,-20553,-20475,-20396,-20318,-20239,
+-20159,-20080,-20001,-19921,-19841,-19761,-19681,-19600,
+-19519,-19439,-19358,-19276,-19195,-19113,-19032,-18950,
+-18868,-18785,-18703,-18620,-18537,-18454,-18371,-18288,
+-18204,-18121,-18037,-17953,-17869,-17784,-17700,-17615,
+-17530,-17445,-17360,-17275,-17189,-17104,-17018,-16932,
+-16846,-16759,-16673,-16586,-16499,-16413,-16325,-16238,
+-16151,-16063,-15976,-15888,-15800,-15712,-15623,-15535,
+-15446,-15357,-15269,-15180,-15090,-15001,-14912,-14822,
+-14732,-14642,-14552,-14462,-14372,-14282,-14191,-14100,
+-14010,-13919,-13828,-13736,-13645,-13554,-13462,-13370,
+-13278,-13186,-13094,-13002,-12910,-12817,-12725,-12632,
+-12539,-12446,-12353,-12260,-12167,-12073,-11980,-11886,
+-11793,-11699,-11605,-11511,-11416,-11322,-11228,-11133,
+-11039,-10944,-10849,-10754,-10659,-10564,-10469,-10374,
+-10278,-10183,-10087,-9991,-9896,-9800,-9704,-9608,
+-9512,-9415,-9319,-9223,-9126,-9029,-8933,-8836,
+-8739,-8642,-8545,-8448,-8351,-8254,-8156,-8059,
+-7961,-7864,-7766,-7669,-7571,-7473,-7375,-7277,
+-7179,-7081,-6983,-6884,-6786,-6688,-6589,-6491,
+-6392,-6294,-6195,-6096,-5997,-5898,-5800,-5701,
+-5602,-5503,-5403,-5304,-5205,-5106,-5006,-4907,
+-4808,-4708,-4609,-4509,-4409,-4310,-4210,-4110,
+-4011,-3911,-3811,-3711,-3611,-3511,-3411,-3311,
+-3211,-3111,-3011,-2911,-2811,-2711,-2611,-2510,
+-2410,-2310,-2210,-2109,-2009,-1909,-1808,-1708,
+-1607,-1507,-1407,-1306,-1206,-1105,-1005,-904,
+-804,-703,-603,-502,-402,-301,-201,-100,
+0,100,201,301,402,502,603,703,
+804,904,1005,1105,1206,1306,1407,1507,
+1607,1708,1808,1909,2009,2109,2210,2310,
+2410,2510,2611,2711,2811,2911,3011,3111,
+3211,3311,3411,3511,3611,3711,3811,3911,
+4011,4110,4210,4310,4409,4509,4609,4708,
+4808,4907,5006,5106,5205,5304,5403,5503,
+5602,5701,5800,5898,5997,6096,6195,6294,
+6392,6491,6589,6688,6786,6884,6983,7081,
+7179,7277,7375,7473,7571,7669,7766,7864,
+7961,8059,8156,8254,8351,8448,8545,8642,
+8739,8836,8933,9029,9126,9223,9319,9415,
+9512,9608,9704,9800,9896,9991,10087,10183,
+10278,10374,10469,10564,10659,10754,10849,10944,
+11039,11133,11228,11322,11416,11511,11605,11699,
+11793,11886,11980,12073,12167,12260,12353,12446,
+12539,12632,12725,12817,12910,13002,13094,13186,
+13278,13370,13462,13554,13645,13736,13828,13919,
+14010,14100,14191,14282,14372,14462,14552,14642,
+14732,14822,14912,15001,15090,15180,15269,15357,
+15446,15535,15623,15712,15800,15888,15976,16063,
+16151,16238,16325,16413,16499,16586,16673,16759,
+16846,16932,17018,17104,17189,17275,17360,17445,
+17530,17615,17700,17784,17869,17953,18037,18121,
+18204,18288,18371,18454,18537,18620,18703,18785,
+18868,18950,19032,19113,19195,19276,19358,19439,
+19519,19600,19681,19761,19841,19921,20001,20080,
+20159,20239,20318,20396,20475,20553,20631,20709,
+20787,20865,20942,21020,21097,21173,21250,21326,
+21403,21479,21555,21630,21706,21781,21856,21931,
+22005,22080,22154,22228,22301,22375,22448,22521,
+22594,22667,22740,22812,22884,22956,23027,23099,
+23170,23241,23312,23382,23453,23523,23593,23662,
+23732,23801,23870,23939,24007,24075,24144,24211,
+24279,24346,24414,24480,24547,24614,24680,24746,
+24812,24877,24943,25008,25073,25137,25201,25266,
+25330,25393,25457,25520,25583,25645,25708,25770,
+25832,25894,25955,26016,26077,26138,26199,26259,
+26319,26379,26438,26498,26557,26615,26674,26732,
+26790,26848,26905,26963,27020,27076,27133,27189,
+27245,27301,27356,27411,27466,27521,27576,27630,
+27684,27737,27791,27844,27897,27949,28002,28054,
+28106,28157,28208,28259,28310,28361,28411,28461,
+28511,28560,28609,28658,28707,28755,28803,28851,
+28898,28946,28993,29039,29086,29132,29178,29223,
+29269,29314,29359,29403,29447,29491,29535,29578,
+29621,29664,29707,29749,29791,29833,29874,29915,
+29956,29997,30037,30077,30117,30156,30196,30235,
+30273,30312,30350,30387,30425,30462,30499,30535,
+30572,30608,30644,30679,30714,30749,30784,30818,
+30852,30886,30919,30952,30985,31018,31050,31082,
+31114,31145,31176,31207,31237,31268,31298,31327,
+31357,31386,31414,31443,31471,31499,31526,31554,
+31581,31607,31634,31660,31685,31711,31736,31761,
+31785,31810,31834,31857,31881,31904,31927,31949,
+31971,31993,32015,32036,32057,32078,32098,32118,
+32138,32157,32176,32195,32214,32232,32250,32268,
+32285,32302,32319,32335,32351,32367,32383,32398,
+32413,32427,32442,32456,32469,32483,32496,32509,
+32521,32533,32545,32557,32568,32579,32589,32600,
+32610,32619,32629,32638,32647,32655,32663,32671,
+32679,32686,32693,32700,32706,32712,32718,32723,
+32728,32733,32737,32741,32745,32749,32752,32755,
+32758,32760,32762,32764,32765,32766,32767,32767,
+32767,32767,32767,32766,32765,32764,32762,32760,
+32758,32755,32752,32749,32745,32741,32737,32733,
+32728,32723,32718,32712,32706,32700,32693,32686,
+32679,32671,32663,32655,32647,32638,32629,32619,
+32610,32600,32589,32579,32568,32557,32545,32533,
+32521,32509,32496,32483,32469,32456,32442,32427,
+32413,32398,32383,32367,32351,32335,32319,32302,
+32285,32268,32250,32232,32214,32195,32176,32157,
+32138,32118,32098,32078,32057,32036,32015,31993,
+31971,31949,31927,31904,31881,31857,31834,31810,
+31785,31761,31736,31711,31685,31660,31634,31607,
+31581,31554,31526,31499,31471,31443,31414,31386,
+31357,31327,31298,31268,31237,31207,31176,31145,
+31114,31082,31050,31018,30985,30952,30919,30886,
+30852,30818,30784,30749,30714,30679,30644,30608,
+30572,30535,30499,30462,30425,30387,30350,30312,
+30273,30235,30196,30156,30117,30077,30037,29997,
+29956,29915,29874,29833,29791,29749,29707,29664,
+29621,29578,29535,29491,29447,29403,29359,29314,
+29269,29223,29178,29132,29086,29039,28993,28946,
+28898,28851,28803,28755,28707,28658,28609,28560,
+28511,28461,28411,28361,28310,28259,28208,28157,
+28106,28054,28002,27949,27897,27844,27791,27737,
+27684,27630,27576,27521,27466,27411,27356,27301,
+27245,27189,27133,27076,27020,26963,26905,26848,
+26790,26732,26674,26615,26557,26498,26438,26379,
+26319,26259,26199,26138,26077,26016,25955,25894,
+25832,25770,25708,25645,25583,25520,25457,25393,
+25330,25266,25201,25137,25073,25008,24943,24877,
+24812,24746,24680,24614,24547,24480,24414,24346,
+24279,24211,24144,24075,24007,23939,23870,23801,
+23732,23662,23593,23523,23453,23382,23312,23241,
+23170,23099,23027,22956,22884,22812,22740,22667,
+22594,22521,22448,22375,22301,22228,22154,22080,
+22005,21931,21856,21781,21706,21630,21555,21479,
+21403,21326,21250,21173,21097,21020,20942,20865,
+20787,20709,20631,20553,20475,20396,20318,20239,
+20159,20080,20001,19921,19841,19761,19681,19600,
+19519,19439,19358,19276,19195,19113,19032,18950,
+18868,18785,18703,18620,18537,18454,18371,18288,
+18204,18121,18037,17953,17869,17784,17700,17615,
+17530,17445,17360,17275,17189,17104,17018,16932,
+16846,16759,16673,16586,16499,16413,16325,16238,
+16151,16063,15976,15888,15800,15712,15623,15535,
+15446,15357,15269,15180,15090,15001,14912,14822,
+14732,14642,14552,14462,14372,14282,14191,14100,
+14010,13919,13828,13736,13645,13554,13462,13370,
+13278,13186,13094,13002,12910,12817,12725,12632,
+12539,12446,12353,12260,12167,12073,11980,11886,
+11793,11699,11605,11511,11416,11322,11228,11133,
+11039,10944,10849,10754,10659,10564,10469,10374,
+10278,10183,10087,9991,9896,9800,9704,9608,
+9512,9415,9319,9223,9126,9029,8933,8836,
+8739,8642,8545,8448,8351,8254,8156,8059,
+7961,7864,7766,7669,7571,7473,7375,7277,
+7179,7081,6983,6884,6786,6688,6589,6491,
+6392,6294,6195,6096,5997,5898,5800,5701,
+5602,5503,5403,5304,5205,5106,5006,4907,
+4808,4708,4609,4509,4409,4310,4210,4110,
+4011,3911,3811,3711,3611,3511,3411,3311,
+3211,3111,3011,2911,2811,2711,2611,2510,
+2410,2310,2210,2109,2009,1909,1808,1708,
+1607,1507,1407,1306,1206,1105,1005,904,
+804,703,603,502,402,301,201,100,
+0,-100,-201,-301,-402,-502,-603,-703,
+-804,-904,-1005,-1105,-1206,-1306,-1407,-1507,
+-1607,-1708,-1808,-1909,-2009,-2109,-2210,-2310,
+-2410,-2510,-2611,-2711,-2811,-2911,-3011,-3111,
+-3211,-3311,-3411,-3511,-3611,-3711,-3811,-3911,
+-4011,-4110,-4210,-4310,-4409,-4509,-4609,-4708,
+-4808,-4907,-5006,-5106,-5205,-5304,-5403,-5503,
+-5602,-5701,-5800,-5898,-5997,-6096,-6195,-6294,
+-6392,-6491,-6589,-6688,-6786,-6884,-6983,-7081,
+-7179,-7277,-7375,-7473,-7571,-7669,-7766,-7864,
+-7961,-8059,-8156,-8254,-8351,-8448,-8545,-8642,
+-8739,-8836,-8933,-9029,-9126,-9223,-9319,-9415,
+-9512,-9608,-9704,-9800,-9896,-9991,-10087,-10183,
+-10278,-10374,-10469,-10564,-10659,-10754,-10849,-10944,
+-11039,-11133,-11228,-11322,-11416,-11511,-11605,-11699,
+-11793,-11886,-11980,-12073,-12167,-12260,-12353,-12446,
+-12539,-12632,-12725,-12817,-12910,-13002,-13094,-13186,
+-13278,-13370,-13462,-13554,-13645,-13736,-13828,-13919,
+-14010,-14100,-14191,-14282,-14372,-14462,-14552,-14642,
+-14732,-14822,-14912,-15001,-15090,-15180,-15269,-15357,
+-15446,-15535,-15623,-15712,-15800,-15888,-15976,-16063,
+-16151,-16238,-16325,-16413,-16499,-16586,-16673,-16759,
+-16846,-16932,-17018,-17104,-17189,-17275,-17360,-17445,
+-17530,-17615,-17700,-17784,-17869,-17953,-18037,-18121,
+-18204,-18288,-18371,-18454,-18537,-18620,-18703,-18785,
+-18868,-18950,-19032,-19113,-19195,-19276,-19358,-19439,
+-19519,-19600,-19681,-19761,-19841,-19921,-20001,-20080,
+-20159,-20239,-20318,-20396,-20475,-20553,-20631,-20709,
+-20787,-20865,-20942,-21020,-21097,-21173,-21250,-21326,
+-21403,-21479,-21555,-21630,-21706,-21781,-21856,-21931,
+-22005,-22080,-22154,-22228,-22301,-22375,-22448,-22521,
+-22594,-22667,-22740,-22812,-22884,-22956,-23027,-23099,
+-23170,-23241,-23312,-23382,-23453,-23523,-23593,-23662,
+-23732,-23801,-23870,-23939,-24007,-24075,-24144,-24211,
+-24279,-24346,-24414,-24480,-24547,-24614,-24680,-24746,
+-24812,-24877,-24943,-25008,-25073,-25137,-25201,-25266,
+-25330,-25393,-25457,-25520,-25583,-25645,-25708,-25770,
+-25832,-25894,-25955,-26016,-26077,-26138,-26199,-26259,
+-26319,-26379,-26438,-26498,-26557,-26615,-26674,-26732,
+-26790,-26848,-26905,-26963,-27020,-27076,-27133,-27189,
+-27245,-27301,-27356,-27411,-27466,-27521,-27576,-27630,
+-27684,-27737,-27791,-27844,-27897,-27949,-28002,-28054,
+-28106,-28157,-28208,-28259,-28310,-28361,-28411,-28461,
+-28511,-28560,-28609,-28658,-28707,-28755,-28803,-28851,
+-28898,-28946,-28993,-29039,-29086,-29132,-29178,-29223,
+-29269,-29314,-29359,-29403,-29447,-29491,-29535,-29578,
+-29621,-29664,-29707,-29749,-29791,-29833,-29874,-29915,
+-29956,-29997,-30037,-30077,-30117,-30156,-30196,-30235,
+-30273,-30312,-30350,-30387,-30425,-30462,-30499,-30535,
+-30572,-30608,-30644,-30679,-30714,-30749,-30784,-30818,
+-30852,-30886,-30919,-30952,-30985,-31018,-31050,-31082,
+-31114,-31145,-31176,-31207,-31237,-31268,-31298,-31327,
+-31357,-31386,-31414,-31443,-31471,-31499,-31526,-31554,
+-31581,-31607,-31634,-31660,-31685,-31711,-31736,-31761,
+-31785,-31810,-31834,-31857,-31881,-31904,-31927,-31949,
+-31971,-31993,-32015,-32036,-32057,-32078,-32098,-32118,
+-32138,-32157,-32176,-32195,-32214,-32232,-32250,-32268,
+-32285,-32302,-32319,-32335,-32351,-32367,-32383,-32398,
+-32413,-32427,-32442,-32456,-32469,-32483,-32496,-32509,
+-32521,-32533,-32545,-32557,-32568,-32579,-32589,-32600,
+-32610,-32619,-32629,-32638,-32647,-32655,-32663,-32671,
+-32679,-32686,-32693,-32700,-32706,-32712,-32718,-32723,
+-32728,-32733,-32737,-32741,-32745,-32749,-32752,-32755,
+-32758,-32760,-32762,-32764,-32765,-32766,-32767,-32767,
+-32768,-32767,-32767,-32766,-32765,-32764,-32762,-32760,
+-32758,-32755,-32752,-32749,-32745,-32741,-32737,-32733,
+-32728,-32723,-32718,-32712,-32706,-32700,-32693,-32686,
+-32679,-32671,-32663,-32655,-32647,-32638,-32629,-32619,
+-32610,-32600,-32589,-32579,-32568,-32557,-32545,-32533,
+-32521,-32509,-32496,-32483,-32469,-32456,-32442,-32427,
+-32413,-32398,-32383,-32367,-32351,-32335,-32319,-32302,
+-32285,-32268,-32250,-32232,-32214,-32195,-32176,-32157,
+-32138,-32118,-32098,-32078,-32057,-32036,-32015,-31993,
+-31971,-31949,-31927,-31904,-31881,-31857,-31834,-31810,
+-31785,-31761,-31736,-31711,-31685,-31660,-31634,-31607,
+-31581,-31554,-31526,-31499,-31471,-31443,-31414,-31386,
+-31357,-31327,-31298,-31268,-31237,-31207,-31176,-31145,
+-31114,-31082,-31050,-31018,-30985,-30952,-30919,-30886,
+-30852,-30818,-30784,-30749,-30714,-30679,-30644,-30608,
+-30572,-30535,-30499,-30462,-30425,-30387,-30350,-30312,
+-30273,-30235,-30196,-30156,-30117,-30077,-30037,-29997,
+-29956,-29915,-29874,-29833,-29791,-29749,-29707,-29664,
+-29621,-29578,-29535,-29491,-29447,-29403,-29359,-29314,
+-29269,-29223,-29178,-29132,-29086,-29039,-28993,-28946,
+-28898,-28851,-28803,-28755,-28707,-28658,-28609,-28560,
+-28511,-28461,-28411,-28361,-28310,-28259,-28208,-28157,
+-28106,-28054,-28002,-27949,-27897,-27844,-27791,-27737,
+-27684,-27630,-27576,-27521,-27466,-27411,-27356,-27301,
+-27245,-27189,-27133,-27076,-27020,-26963,-26905,-26848,
+-26790,-26732,-26674,-26615,-26557,-26498,-26438,-26379,
+-26319,-26259,-26199,-26138,-26077,-26016,-25955,-25894,
+-25832,-25770,-25708,-25645,-25583,-25520,-25457,-25393,
+-25330,-25266,-25201,-25137,-25073,-25008,-24943,-24877,
+-24812,-24746,-24680,-24614,-24547,-24480,-24414,-24346,
+-24279,-24211,-24144,-24075,-24007,-23939,-23870,-23801,
+-23732,-23662,-23593,-23523,-23453,-23382,-23312,-23241,
+-23170,-23099,-23027,-22956,-22884,-22812,-22740,-22667,
+-22594,-22521,-22448,-22375,-22301,-22228,-22154,-22080,
+-22005,-21931,-21856,-21781,-21706,-21630,-21555,-21479,
+-21403,-21326,-21250,-21173,-21097,-21020,-20942,-20865,
+-20787,-20709,-20631,-20553,-20475,-20396,-20318,-20239,
+-20159,-20080,-20001,-19921,-19841,-19761,-19681,-19600,
+-19519,-19439,-19358,-19276,-19195,-19113,-19032,-18950,
+-18868,-18785,-18703,-18620,-18537,-18454,-18371,-18288,
+-18204,-18121,-18037,-17953,-17869,-17784,-17700,-17615,
+-17530,-17445,-17360,-17275,-17189,-17104,-17018,-16932,
+-16846,-16759,-16673,-16586,-16499,-16413,-16325,-16238,
+-16151,-16063,-15976,-15888,-15800,-15712,-15623,-15535,
+-15446,-15357,-15269,-15180,-15090,-15001,-14912,-14822,
+-14732,-14642,-14552,-14462,-14372,-14282,-14191,-14100,
+-14010,-13919,-13828,-13736,-13645,-13554,-13462,-13370,
+-13278,-13186,-13094,-13002,-12910,-12817,-12725,-12632,
+-12539,-12446,-12353,-12260,-12167,-12073,-11980,-11886,
+-11793,-11699,-11605,-11511,-11416,-11322,-11228,-11133,
+-11039,-10944,-10849,-10754,-10659,-10564,-10469,-10374,
+-10278,-10183,-10087,-9991,-9896,-9800,-9704,-9608,
+-9512,-9415,-9319,-9223,-9126,-9029,-8933,-8836,
+-8739,-8642,-8545,-8448,-8351,-8254,-8156,-8059,
+-7961,-7864,-7766,-7669,-7571,-7473,-7375,-7277,
+-7179,-7081,-6983,-6884,-6786,-6688,-6589,-6491,
+-6392,-6294,-6195,-6096,-5997,-5898,-5800,-5701,
+-5602,-5503,-5403,-5304,-5205,-5106,-5006,-4907,
+-4808,-4708,-4609,-4509,-4409,-4310,-4210,-4110,
+-4011,-3911,-3811,-3711,-3611,-3511,-3411,-3311,
+-3211,-3111,-3011,-2911,-2811,-2711,-2611,-2510,
+-2410,-2310,-2210,-2109,-2009,-1909,-1808,-1708,
+-1607,-1507,-1407,-1306,-1206,-1105,-1005,-904,
+-804,-703,-603,-502,-402,-301,-201,-100,
+};
@@ -0,0 +1,20 @@
+// Autogenerated file
+#pragma once
+#include <stdint.h>
+
+#define EXP_TABLE_SIZE 1024
+#define CENTS_TABLE_LEN 100
+#define CENTS_TABLE_BITS 31
+#define SVFREQ_FINE_BITS 14
+#define SVFREQ_FINE_TABLE_BITS 8
+#define GRAIN_WINDOW_BITS 8
+#define FM_SINE_BITS 11
+
+extern const float exp_table[1024];		// exp(x) for x in 0..1
+extern float svfreq_map_table[128];		// Filter cutoff coefficient per parameter step
+extern int16_t svfreq_map_table_q15[128];
+extern float svfreq_fine_table[257];		// Filter cutoff coefficient, for interpolating between parameter steps
+extern const uint32_t note_table[128];		// Phase increment per sample for each MIDI note
+extern const uint32_t cents_table[100];		// Frequency ratio for 0..99 cents, with 31 fractional bits
+extern int16_t grain_window_table[257];		// Hann window for granular playback, Q15
+extern int16_t fm_sine_table[4096];		// Sine for FM operators, two cycles, Q15
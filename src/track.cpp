@@ -1,18 +1,25 @@
 #include <stdio.h>
 #include <cstdint>
 #include <cstring>
+#include <math.h>
 #include "common.h"
 #include "track.hpp"
 #include "keyboard.h"
 #include "sample.hpp"
 #include "hw/psram_spi.h"
+#include "hardware/sync.h"
 
 // Total count of elapsed samples
 // at 48 kHz this uint32 value will overflow after 24 hours
 static uint32_t sampletick;
 
 AcidBass acid;
-TestSynth testsynth;
+DrumSynth drums;
+PolySynth polysynth;
+Granular granular;
+FMSynth fmsynth;
+// Only the sample channels get a sampler, each holds a block of frames per voice
+Sampler samplers[3];
 
 
 void Track::reset() {
@@ -24,18 +31,44 @@ void Track::reset() {
     channels[0].inst->init();
 
     channels[1].type = CHANNEL_INSTRUMENT;
-    channels[1].inst = &testsynth;
+    channels[1].inst = &drums;
     channels[1].inst->init();
 
     channels[2].type = CHANNEL_SAMPLE;
-    channels[3].type = CHANNEL_SAMPLE;  
+    channels[2].sampler = &samplers[0];
+    channels[2].sampler->init();
+    channels[3].type = CHANNEL_SAMPLE;
+    channels[3].sampler = &samplers[1];
+    channels[3].sampler->init();
+
+    channels[4].type = CHANNEL_INSTRUMENT;
+    channels[4].inst = &polysynth;
+    channels[4].inst->init();
+
+    channels[5].type = CHANNEL_INSTRUMENT;
+    channels[5].inst = &granular;
+    channels[5].inst->init();
+
+    channels[6].type = CHANNEL_INSTRUMENT;
+    channels[6].inst = &fmsynth;
+    channels[6].inst->init();
+
+    // Unassigned, left as a sample channel
+    channels[7].type = CHANNEL_SAMPLE;
+    channels[7].sampler = &samplers[2];
+    channels[7].sampler->init();
     
     active_channel = 0;
     for (int v=0; v<NUM_CHANNELS; v++) {
-        channels[v].next_off_time = 1;
+        channels[v].clear_events();
     }
 
     step_data.init();
+
+    if (!delay.init()) {
+        DEBUG_PRINTF("delay: allocation failed\n");
+    }
+    reverb.init();
 }
 
 void Track::set_volume_percent(int vol) {
@@ -44,6 +77,28 @@ void Track::set_volume_percent(int vol) {
     volume = vol/100.0f;
 }
 
+void Track::set_channel_volume_percent(int chan, int vol) {
+    if (chan < 0 || chan >= NUM_CHANNELS) return;
+    if (vol < 0) vol = 0;
+    if (vol > 100) vol = 100;
+    channels[chan].volume = vol/100.0f;
+}
+
+void Track::set_channel_pan_percent(int chan, int pan) {
+    if (chan < 0 || chan >= NUM_CHANNELS) return;
+    if (pan < -100) pan = -100;
+    if (pan > 100) pan = 100;
+    channels[chan].pan = pan/100.0f;
+}
+
+void Track::set_reverb_quality(int quality) {
+    reverb.set_quality(quality);
+}
+
+void Track::set_reverb_decay(float seconds) {
+    reverb.set_decay(seconds);
+}
+
 void Track::enable_keyboard(bool en) {
     keyboard_enabled = en;
     if (!en) {
@@ -56,27 +111,22 @@ void Track::play(bool start_playing) {
 
     for (int v=0; v<NUM_CHANNELS; v++) {
         Channel *c = &channels[v];
+        c->clear_events();
+        c->stepno = 0;
 
         if (start_playing) {
-            c->stepno = 0;
+            // First step plays immediately
+            c->next_step_idx = 0;
             c->next_step_time = sampletick;
-            c->step_on = false;
-            first_step = true;
-
-            // Play first note immediately
-            const Step first_step = step_data.get_step(current_pattern, v, c->stepno);
-            if (first_step.on) {
-                c->next_on_time = sampletick;
-                int len = (samples_per_step * first_step.gate_length) >> GATE_LENGTH_BITS;
-                c->next_off_time = c->next_on_time + len;
-                c->next_step = first_step;
-            }
-        } else {
-            c->stepno = 0;
-            c->next_on_time = 0;
-            c->next_off_time = sampletick;
+        } else if (c->type == CHANNEL_INSTRUMENT) {
+            ChannelEvent off {};
+            off.time = sampletick;
+            off.type = EVENT_ALL_NOTES_OFF;
+            c->push_event(off);
         }
     }
+
+    if (start_playing) schedule();
 }
 
 void Track::schedule() {
@@ -86,48 +136,77 @@ void Track::schedule() {
         bpm_old = bpm;
     }
 
-    // Schedule next note for each channel
-    if (is_playing) {
-        for (int v=0; v<NUM_CHANNELS; v++) {
-            Channel *c = &channels[v];
-
-            if (!c->step_on && sampletick > c->next_step_time) {
-                // Increment step
-                if (!first_step) c->stepno = next_note_idx(v);
-
-                // Now that we are in the "next" step, and it has started,
-                // we can set the on_time for the next step
-                c->next_step_time += samples_per_step;
-                int nn = next_note_idx(v);
-                const Step next_step = step_data.get_step(current_pattern, v, nn);
-                if (next_step.on) {
-                    c->next_on_time = c->next_step_time;
-                    c->next_step = next_step;
-                    c->step_on = true;
-                }
-            } else if (c->step_on && sampletick > c->next_off_time) {
-                // Step off time reached, set off time for the next step
-                int nn = next_note_idx(v);
-                const Step next_step = step_data.get_step(current_pattern, v, nn);
-                int len = (samples_per_step * next_step.gate_length) >> GATE_LENGTH_BITS;
-                c->next_off_time = c->next_on_time + len;
-                c->step_on = false;
-            }
+    if (!is_playing) return;
+
+    // Queue the steps for each channel which start before the horizon,
+    // leaving some space in the queue for keyboard events
+    const uint32_t horizon = sampletick + SCHEDULE_AHEAD_SAMPS;
+    for (int v=0; v<NUM_CHANNELS; v++) {
+        Channel *c = &channels[v];
+        while ((int32_t)(horizon - c->next_step_time) > 0 && c->events.space() >= 2*EVENTS_PER_STEP) {
+            schedule_step(v);
         }
-        first_step = false;
     }
 }
 
-int Track::next_note_idx(int channel) {
+void Track::background() {
+    for (int v=0; v<NUM_CHANNELS; v++) {
+        if (channels[v].type == CHANNEL_INSTRUMENT) channels[v].inst->background();
+    }
+}
+
+void Track::schedule_step(int chan) {
+    Channel *c = &channels[chan];
+    const Step step = step_data.get_step(current_pattern, chan, c->next_step_idx);
+    const uint32_t time = c->next_step_time;
+
+    ChannelEvent evt {};
+    evt.time = time;
+    evt.type = EVENT_STEP;
+    evt.value = c->next_step_idx;
+    c->push_event(evt);
+
+    if (step.on) {
+        evt.midi_note = step.midi_note;
+        evt.accent = step.accent;
+
+        if (c->type == CHANNEL_INSTRUMENT && step.trigger) {
+            // Steps play legato, the envelope only restarting after a gap
+            evt.type = EVENT_NOTE_ON;
+            evt.retrigger = false;
+            c->push_event(evt);
+
+            evt.type = EVENT_NOTE_OFF;
+            evt.time = time + ((samples_per_step * step.gate_length) >> GATE_LENGTH_BITS);
+            c->push_event(evt);
+
+        } else if (c->type == CHANNEL_SAMPLE) {
+            evt.type = EVENT_SAMPLE_TRIGGER;
+            evt.value = step.sample_id;
+            evt.trigger_id = c->trigger_count++;
+            c->push_event(evt);
+
+            // Ends a looping sample, but not one started again since
+            evt.type = EVENT_NOTE_OFF;
+            evt.time = time + ((samples_per_step * step.gate_length) >> GATE_LENGTH_BITS);
+            c->push_event(evt);
+        }
+    }
+
+    c->next_step_time += samples_per_step;
+    c->next_step_idx = next_step(c->next_step_idx);
+}
+
+int Track::next_step(int stepno) {
     if (pattern[current_pattern].length == 0) return 0;
-    return (channels[channel].stepno + 1) % pattern[current_pattern].length;
+    return (stepno + 1) % pattern[current_pattern].length;
 }
 
 bool Track::get_channel_activity(int chan) {
     if (channels[chan].type == CHANNEL_INSTRUMENT) {
         return channels[chan].inst->gate;
     } else if (channels[chan].type == CHANNEL_SAMPLE) {
-        return (channels[chan].cur_sample_id >= 0);
+        return !channels[chan].sampler->is_idle();
     }
     return false;
 }
@@ -138,97 +217,203 @@ void Track::control_active_channel(const InputState &input) {
     }
 }
 
-void Track::play_active_channel(const InputState &input) {
-    static int current_key = -1;
+// Note played by each key, so the right note is released even if the octave has changed
+static int key_note[NUM_STEPKEYS];
+// Releases which didn't fit in the event queue, retried every buffer so the note can't hang
+static int key_release[NUM_STEPKEYS];
 
+void Track::play_key(int key, bool down, int offset, const InputState &input) {
+    if (key >= NUM_STEPKEYS) return;
     if (!keyboard_enabled || keyboard_inhibited) return;
 
-    bool oct_dn = btn_down(&input, BTN_LEFT);
-    bool oct_up = btn_down(&input, BTN_RIGHT);
-    int shift = oct_up - oct_dn;
-
-    int (*map)(int, int) = keymap_pentatonic_linear;
-
-    // Triggers
-    bool any_triggered = false;
-    bool any_released = false;
-    for (int b=0; b<NUM_STEPKEYS; b++) {
-        if (input.button_state[b] == BTN_RELEASED) any_released = true;
-        if (input.button_state[b] == BTN_PRESSED) {
-            any_triggered = true;
-            current_key = b;
-            int midi_note = map(b, shift);
-            if (midi_note > 0) {
-                uint32_t freq = midi_note_to_freq(midi_note);
-                channels[active_channel].inst->trigger = 1;
-                channels[active_channel].inst->accent = btn_down(&input, BTN_SHIFT);
-                channels[active_channel].inst->gate = 1;
-                channels[active_channel].inst->note_freq = freq;
-
-                // Store last played note for the sequencer
-                last_played_midi_note = midi_note;
-            }
+    Channel *c = &channels[active_channel];
+    ChannelEvent evt {};
+    evt.time = sampletick + offset;
+
+    if (down) {
+        bool oct_dn = btn_down(&input, BTN_LEFT);
+        bool oct_up = btn_down(&input, BTN_RIGHT);
+        int shift = oct_up - oct_dn;
+
+        // Drop the note rather than take the last space in the queue, which its release needs
+        int midi_note = keymap_pentatonic_linear(key, shift);
+        if (midi_note > 0 && c->events.space() >= 2) {
+            key_note[key] = midi_note;
+            evt.type = EVENT_NOTE_ON;
+            evt.midi_note = midi_note;
+            evt.accent = btn_down(&input, BTN_SHIFT);
+            evt.retrigger = true;
+            c->push_event(evt);
+
+            // Store last played note for the sequencer
+            last_played_midi_note = midi_note;
         }
+
+    // For a monophonic instrument this only stops the note
+    // if no other key has been pressed since
+    } else if (key_note[key] > 0) {
+        key_release[key] = key_note[key];
+        key_note[key] = 0;
+        release_keys(evt.time);
+    }
+}
+
+void Track::release_keys(uint32_t time) {
+    Channel *c = &channels[active_channel];
+    for (int k=0; k<NUM_STEPKEYS; k++) {
+        if (key_release[k] <= 0) continue;
+        ChannelEvent evt {};
+        evt.time = time;
+        evt.type = EVENT_NOTE_OFF;
+        evt.midi_note = key_release[k];
+        if (c->push_event(evt)) key_release[k] = 0;
     }
+}
 
-    if (!any_triggered && any_released) {
-        for (int b=0; b<NUM_STEPKEYS; b++) {
-            if (input.button_state[b] == BTN_RELEASED) {
-                if (current_key == b) {
-                    channels[active_channel].inst->gate = 0;
-                }
-            }
+void Track::start_channels(int n) {
+    buffer_samps = n;
+    release_keys(sampletick);
+
+    // Sort by cost so the expensive channels get started first and the
+    // cheap ones fill in the gaps at the end
+    for (int i=0; i<NUM_CHANNELS; i++) channel_order[i] = i;
+    for (int i=1; i<NUM_CHANNELS; i++) {
+        uint8_t chan = channel_order[i];
+        int j = i;
+        while (j > 0 && channels[channel_order[j-1]].cost < channels[chan].cost) {
+            channel_order[j] = channel_order[j-1];
+            j--;
         }
+        channel_order[j] = chan;
     }
+
+    update_mix_gains();
+
+    channels_done = 0;
+    __atomic_store_n(&next_claim, 0, __ATOMIC_RELEASE);
 }
 
-void Track::process_channels(uint32_t channel_mask) {
+int Track::process_channels() {
+    int count = 0;
 
-    int chan = 0;
-    while (chan < NUM_CHANNELS) {
-        if (channel_mask & 1) {
-            if (!channels[chan].is_muted) {
-                channels[chan].fill_buffer(sampletick);
-            }
+    while (1) {
+        uint32_t idx = __atomic_fetch_add(&next_claim, 1, __ATOMIC_ACQ_REL);
+        if (idx == NUM_CHANNELS) {
+            // One past the last channel is the reverb
+            reverb_active = reverb.process(send_acc[SEND_REVERB], reverb_out, buffer_samps);
+            __atomic_fetch_add(&channels_done, 1, __ATOMIC_RELEASE);
+            break;
         }
+        if (idx > NUM_CHANNELS) break;
 
-        channel_mask >>= 1;
-        chan++;
+        Channel *c = &channels[channel_order[idx]];
+        uint32_t start = time_us_32();
+        if (!c->is_muted) {
+            c->fill_buffer(sampletick, buffer_samps);
+        } else {
+            c->skip_buffer(sampletick + buffer_samps);
+        }
+        uint32_t elapsed = time_us_32() - start;
+        c->cost += ((int32_t)(16 * elapsed) - (int32_t)c->cost) >> 3;
+        if (c->is_active) count++;
+        __atomic_fetch_add(&channels_done, 1, __ATOMIC_RELEASE);
     }
+
+    return count;
 }
 
-void Track::downmix(AudioBuffer buffer) {
-    int16_t *samples = (int16_t *) buffer.samples;
-    memset(samples, 0, 2*BUFFER_SIZE_SAMPS);
+void Track::wait_channels() {
+    while (__atomic_load_n(&channels_done, __ATOMIC_ACQUIRE) < NUM_CHANNELS + 1) {
+        tight_loop_contents();
+    }
+}
+
+void Track::update_mix_gains() {
+    // Volume & convert to 16-bit
+    const float out_scale = volume * 0.2f * 32767;
 
-    for (int sn=0; sn<BUFFER_SIZE_SAMPS; sn++) {
-        float sample = 0.0f;
+    for (int v=0; v<NUM_CHANNELS; v++) {
+        const float gain = channels[v].is_muted ? 0.0f : channels[v].volume * out_scale;
 
-        for (int v=0; v<NUM_CHANNELS; v++) {
-            if (channels[v].is_muted) continue;
+        // Constant power pan, scaled so a centred channel is as loud on each side as it was in mono
+        const float angle = (channels[v].pan + 1.0f) * (float)M_PI / 4;
+        const float pan_gain[2] = {(float)M_SQRT2 * cosf(angle), (float)M_SQRT2 * sinf(angle)};
 
-            // Volume & convert to 16-bit
-            sample += channels[v].buffer[sn] * volume * 0.2f * 32767;
+#ifdef AUDIO_Q15
+        for (int side=0; side<2; side++) {
+            mix_gain[v][side] = gain * pan_gain[side] / Q15_CHANNEL_ONE * (1 << Q15_MIX_GAIN_BITS);
+        }
+        for (int s=0; s<NUM_SENDS; s++) {
+            send_gain[v][s] = gain * channels[v].send[s] / 100.0f / Q15_CHANNEL_ONE * (1 << Q15_MIX_GAIN_BITS);
+        }
+#else
+        for (int side=0; side<2; side++) {
+            mix_gain[v][side] = gain * pan_gain[side];
+        }
+        for (int s=0; s<NUM_SENDS; s++) {
+            send_gain[v][s] = gain * channels[v].send[s] / 100.0f;
         }
+#endif
+    }
+}
 
-        // TODO: a proper limiter
-        const float vlimit = 20000.0f;
-        if (sample > vlimit) { 
-            sample = vlimit;
-        } 
-        else if (sample < -vlimit) {
-            sample = -vlimit;
-        }        
+void Track::mix(int start, int len) {
+    mix_t *acc = &mix_acc[2*start];
+    if (reverb_active) {
+        memcpy(acc, &reverb_out[2*start], 2 * len * sizeof(mix_t));
+    } else {
+        memset(acc, 0, 2 * len * sizeof(mix_t));
+    }
+    for (int s=0; s<NUM_SENDS; s++) {
+        memset(&send_acc[s][start], 0, len * sizeof(mix_t));
+    }
 
-        samples[sn] = (int16_t)sample;
+    for (int v=0; v<NUM_CHANNELS; v++) {
+        if (!channels[v].is_active) continue;
+        const sample_t *in = &channels[v].buffer[start];
+
+        if (mix_gain[v][0] != 0 || mix_gain[v][1] != 0) {
+#ifdef AUDIO_Q15
+            q15_mix_stereo_block(acc, in, mix_gain[v][0], mix_gain[v][1], len);
+#else
+            const float gain_l = mix_gain[v][0];
+            const float gain_r = mix_gain[v][1];
+            for (int sn=0; sn<len; sn++) {
+                acc[2*sn]   += in[sn] * gain_l;
+                acc[2*sn+1] += in[sn] * gain_r;
+            }
+#endif
+        }
+
+        for (int s=0; s<NUM_SENDS; s++) {
+            if (send_gain[v][s] == 0) continue;
+            mix_t *send = &send_acc[s][start];
+#ifdef AUDIO_Q15
+            q15_mix_block(send, in, send_gain[v][s], len);
+#else
+            const float gain = send_gain[v][s];
+            for (int sn=0; sn<len; sn++) {
+                send[sn] += in[sn] * gain;
+            }
+#endif
+        }
     }
+}
 
-    sampletick += BUFFER_SIZE_SAMPS;
+void Track::end_buffer(int16_t *out) {
+    // The delay line is read and written once per buffer, here
+    delay.set_time(samples_per_step * delay_steps);
+    delay.set_feedback(delay_feedback / 100.0f);
+    delay.set_tone(delay_tone / 100.0f);
+    delay.process(send_acc[SEND_DELAY], mix_acc, buffer_samps);
 
-    // // See if note events will occur during this buffer
-    // //bool note_events = false;
-    // //if (voice[0].next_note.on_time >= sampletick && voice[0].next_note.on_time < sampletick+count) note_events = true;
-    // //if (voice[0].next_note.off_time >= sampletick && voice[0].next_note.off_time < sampletick+count) note_events = true;
+    limiter.process(mix_acc, out, buffer_samps);
+    sampletick += buffer_samps;
+}
+
+void Track::downmix(AudioBuffer buffer) {
+    mix(0, buffer_samps);
+    end_buffer((int16_t *) buffer.samples);
 }
 
 
@@ -237,62 +422,170 @@ void Track::downmix(AudioBuffer buffer) {
 void Channel::mute(bool mute) {
     is_muted = mute;
     if (mute && type == CHANNEL_INSTRUMENT) {
-        inst->gate = false;
+        inst->silence();
     }
 }
 
 void Channel::silence() {
     if (type == CHANNEL_INSTRUMENT) {
         inst->silence();
+    } else if (type == CHANNEL_SAMPLE) {
+        sampler->silence();
     }
 }
 
-float Channel::process() {
+bool Channel::is_idle() {
     if (type == CHANNEL_INSTRUMENT) {
-        return inst->process();
+        return inst->is_idle();
+    } else if (type == CHANNEL_SAMPLE) {
+        return sampler->is_idle();
+    }
+    return true;
+}
 
+void Channel::render(sample_t *out, int n) {
+    if (type == CHANNEL_INSTRUMENT) {
+        inst->process_block(out, n);
     } else if (type == CHANNEL_SAMPLE) {
-        if (cur_sample_id < 0) return 0.0f;
-        int16_t s = SampleManager::fetch(cur_sample_id, cur_sample_pos);
-        cur_sample_pos += cur_sample_ratio;
-        
-        return s/32768.0f;
+        sampler->process(out, n);
+    } else {
+        memset(out, 0, n * sizeof(sample_t));
     }
-    return 0.0f;
-}
-
-void Channel::fill_buffer(uint32_t start_tick) {
-    for (int sn=0; sn<BUFFER_SIZE_SAMPS; sn++) {
-        uint32_t tick = start_tick + sn;
-
-        if (type == CHANNEL_INSTRUMENT) {
-            if (tick == next_on_time) {
-                // Set up instrument to play next note now
-                //set_note_on_instrument(channels[v].inst, &channels[v].next_note);
-                inst->gate = next_step.trigger; // NOTE: trigger becomes gate
-                inst->accent = next_step.accent;
-                uint32_t freq = midi_note_to_freq(next_step.midi_note);
-                inst->note_freq = freq;
-            } else if (tick == next_off_time) {
-                inst->gate = 0;
-                inst->trigger = 0;
-            }
+}
+
+void Channel::handle_event(const ChannelEvent &evt) {
+    switch (evt.type) {
+    case EVENT_STEP:
+        stepno = evt.value;
+        break;
+
+    case EVENT_NOTE_ON:
+        if (type == CHANNEL_INSTRUMENT) inst->note_on(evt.midi_note, evt.accent, evt.retrigger);
+        break;
+
+    case EVENT_NOTE_OFF:
+        if (type == CHANNEL_INSTRUMENT) inst->note_off(evt.midi_note);
+        else if (type == CHANNEL_SAMPLE) sampler->release(evt.trigger_id);
+        break;
+
+    case EVENT_SAMPLE_TRIGGER:
+        if (type == CHANNEL_SAMPLE) sampler->trigger(evt.value, evt.midi_note, evt.trigger_id);
+        break;
+
+    case EVENT_PARAM:
+        if (type == CHANNEL_INSTRUMENT) inst->set_param(evt.param, evt.value);
+        break;
+
+    case EVENT_ALL_NOTES_OFF:
+        if (type == CHANNEL_INSTRUMENT) inst->silence();
+        else if (type == CHANNEL_SAMPLE) sampler->silence();
+        break;
+    }
+}
 
-        } else if (type == CHANNEL_SAMPLE) {
-            if (tick == next_on_time) {
-                cur_sample_id = next_step.sample_id;
-                cur_sample_pos = 0;
-                if (cur_sample_id >= 0) {
-                    uint32_t play_freq = midi_note_to_freq(next_step.midi_note);
-                    SampleInfo *samp = SampleManager::get_info(cur_sample_id);
-                    uint32_t root_freq = midi_note_to_freq(samp->root_midi_note);
-                    cur_sample_ratio = (float)play_freq / root_freq;
-                }
+void Channel::fill_buffer(uint32_t start_tick, int n) {
+    const uint32_t end_tick = start_tick + n;
+    ChannelEvent evt;
+
+    // While idle, nothing is rendered so events can be applied as soon as they are
+    // in this buffer. Stop at the first one that wakes the channel up.
+    if (is_idle()) {
+        while (events.peek(&evt) && (int32_t)(evt.time - end_tick) < 0) {
+            if (evt.type == EVENT_NOTE_ON || evt.type == EVENT_SAMPLE_TRIGGER) break;
+            events.pop();
+            handle_event(evt);
+        }
+        if (!events.peek(&evt) || (int32_t)(evt.time - end_tick) >= 0) {
+            is_active = false;
+            return;
+        }
+    }
+    is_active = true;
+
+    // Split the buffer only where events land, rendering each run in one go
+    int pos = 0;
+    while (pos < n) {
+        const uint32_t tick = start_tick + pos;
+        int len = n - pos;
+
+        // Apply events due now. Late events are applied straight away rather than lost.
+        while (events.peek(&evt)) {
+            int32_t dt = evt.time - tick;
+            if (dt > 0) {
+                if (dt < len) len = dt;
+                break;
             }
+            events.pop();
+            handle_event(evt);
+        }
+
+        if (is_idle()) {
+            memset(&buffer[pos], 0, len * sizeof(sample_t));
+        } else {
+            render(&buffer[pos], len);
         }
+        pos += len;
+    }
+}
+
+void Channel::skip_buffer(uint32_t end_tick) {
+    is_active = false;
+    ChannelEvent evt;
+    while (events.peek(&evt) && (int32_t)(evt.time - end_tick) < 0) {
+        events.pop();
+        if (evt.type == EVENT_STEP) handle_event(evt);
+    }
+}
+
+// The queue is filled from the main loop and the audio callback on core 0, and drained
+// by the audio callback on either core. Core 1 only renders while the core 0 callback
+// is running, so disabling interrupts is enough to keep the queue consistent.
+bool Channel::push_event(const ChannelEvent &evt) {
+    uint32_t irq = save_and_disable_interrupts();
+    bool ok = events.push(evt);
+    restore_interrupts(irq);
+    return ok;
+}
+
+void Channel::clear_events() {
+    uint32_t irq = save_and_disable_interrupts();
+    events.clear();
+    restore_interrupts(irq);
+}
+
+
+
+void EventQueue::clear() {
+    head = 0;
+    count = 0;
+}
+
+bool EventQueue::push(const ChannelEvent &evt) {
+    if (count == EVENT_QUEUE_SIZE) return false;
 
-        buffer[sn] = process();
+    // Insertion sort from the back: move later events up one place
+    int i = count;
+    while (i > 0) {
+        const ChannelEvent *prev = &events[(head + i - 1) % EVENT_QUEUE_SIZE];
+        if ((int32_t)(prev->time - evt.time) <= 0) break;
+        events[(head + i) % EVENT_QUEUE_SIZE] = *prev;
+        i--;
     }
+    events[(head + i) % EVENT_QUEUE_SIZE] = evt;
+    count++;
+    return true;
+}
+
+bool EventQueue::peek(ChannelEvent *evt) {
+    if (count == 0) return false;
+    *evt = events[head];
+    return true;
+}
+
+void EventQueue::pop() {
+    if (count == 0) return;
+    head = (head + 1) % EVENT_QUEUE_SIZE;
+    count--;
 }
 
 
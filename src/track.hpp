@@ -1,6 +1,11 @@
 #pragma once
 #include "synth_common.hpp"
 #include "instrument.hpp"
+#include "limiter.hpp"
+#include "delay.hpp"
+#include "reverb.hpp"
+#include "sampler.hpp"
+#include "benchmark.h"
 
 #define DEFAULT_BPM 120
 #define NUM_CHANNELS 8
@@ -8,6 +13,12 @@
 #define PATTERN_MAX_LEN 64
 #define GATE_LENGTH_BITS 7
 
+// How far ahead the sequencer puts events into the channel queues.
+// Notes are still played on time as long as the UI loop runs at least this often.
+#define SCHEDULE_AHEAD_SAMPS (SAMPLE_RATE / 10)
+#define EVENT_QUEUE_SIZE 32
+#define EVENTS_PER_STEP 3
+
 struct Step {
     uint8_t midi_note;
     uint8_t gate_length {96};
@@ -34,6 +45,51 @@ private:
 
 
 
+enum ChannelEventType {
+    EVENT_STEP,             // sequencer moved on to step number 'value'
+    EVENT_NOTE_ON,
+    EVENT_NOTE_OFF,
+    EVENT_SAMPLE_TRIGGER,   // play sample 'value' at pitch 'midi_note', as 'trigger_id'
+    EVENT_PARAM,            // set instrument parameter 'param' to 'value'
+    EVENT_ALL_NOTES_OFF
+};
+
+struct ChannelEvent {
+    uint32_t time;          // sample tick the event happens on
+    uint8_t type;
+    uint8_t midi_note;
+    uint8_t param;
+    bool accent;
+    bool retrigger;         // note on restarts the envelope even if the gate is held
+    int16_t value;
+    uint16_t trigger_id;    // sample channels: the note off for a trigger carries its id
+};
+
+// Fixed-capacity queue of events for one channel, kept sorted by time.
+// Events with the same time stay in the order they were pushed.
+class EventQueue {
+public:
+    void clear();
+    bool push(const ChannelEvent &evt);
+    bool peek(ChannelEvent *evt);
+    void pop();
+    int space() { return EVENT_QUEUE_SIZE - count; }
+
+private:
+    ChannelEvent events[EVENT_QUEUE_SIZE];
+    int head;
+    int count;
+};
+
+
+
+// Send effects on the master bus
+enum Send {
+    SEND_DELAY,
+    SEND_REVERB,
+    NUM_SENDS
+};
+
 // Channels can be sample channels, where each step can be an arbitrary sample,
 // or instrument channels, which play notes from a single instrument
 enum ChannelType {
@@ -45,26 +101,41 @@ class Channel {
 public:
     void mute(bool mute);
     void silence();
-    float process();
-    void fill_buffer(uint32_t start_tick);
+    // Render n samples starting at start_tick
+    void fill_buffer(uint32_t start_tick, int n);
+
+    // Queue an event. Safe to call from the main loop or the audio callback.
+    bool push_event(const ChannelEvent &evt);
+    void clear_events();
+    // Consume events before end_tick without rendering, keeping the step position up to date
+    void skip_buffer(uint32_t end_tick);
+
+    // Render a run of n samples in which no events occur
+    void render(sample_t *out, int n);
+    void handle_event(const ChannelEvent &evt);
+
+    // An idle channel outputs silence until an event wakes it up
+    bool is_idle();
 
     ChannelType type;
     Instrument *inst;
     bool is_muted;
-    int stepno;
-    Step next_step;
-    uint32_t next_on_time;
-    uint32_t next_off_time;
-    int samples_per_step;
+    float volume {1.0f};
+    float pan {0.0f};       // -1 (left) to 1 (right)
+    int send[NUM_SENDS] {}; // percent, after volume
+    bool is_active;         // buffer holds audio from the last fill_buffer
+    int stepno;             // step currently playing
+
+    EventQueue events;
+    uint32_t next_step_time;    // time of the next step to be scheduled
+    int next_step_idx;          // and its step number
 
-    int cur_sample_id {-1};
-    float cur_sample_pos;
-    float cur_sample_ratio;
+    uint32_t cost;              // smoothed render time, us * 16
 
-    float buffer[BUFFER_SIZE_SAMPS];
+    Sampler *sampler;           // for sample channels
+    uint16_t trigger_count;     // ids for the sample triggers scheduled
 
-    bool step_on;
-    uint32_t next_step_time;
+    sample_t buffer[BUFFER_SIZE_SAMPS];
 };
 
 
@@ -74,18 +145,48 @@ public:
     void reset();
     void play(bool start_playing);
     void control_active_channel(const InputState &input);
-    void play_active_channel(const InputState &input);
+    // Play or release a note on the active channel from one of the step keys, offset
+    // samples into the buffer about to be rendered. input gives the other buttons.
+    void play_key(int key, bool down, int offset, const InputState &input);
 
-    // Call frequently to ensure the next notes in the pattern are scheduled
+    // Call frequently to ensure the next notes in the pattern are scheduled.
+    // Events are queued up to SCHEDULE_AHEAD_SAMPS ahead of the audio.
     void schedule();
-
-    // Fill channel buffer for channels in the mask
-    void process_channels(uint32_t channel_mask);
-
-    // Mix all channel buffers down into the given output buffer
+    // Slow work for the instruments, called from the main loop
+    void background();
+
+    // Channels are shared out between the cores at runtime. start_channels() is called
+    // once per buffer, with its size in samples, then process_channels() on both cores
+    // at the same time: each core
+    // claims the next unrendered channel, most expensive first, until none are left.
+    // The first core to run out of channels then runs the reverb, on the sends mixed
+    // in the previous buffer.
+    // Returns the number of channels rendered by the calling core; idle channels are skipped.
+    void start_channels(int n);
+    int process_channels();
+    // Size of the buffer being rendered
+    int get_buffer_size() { return buffer_samps; }
+    // Wait until all channels and the reverb have been rendered, by either core
+    void wait_channels();
+
+    // Mix samples start..start+len of all active channels, which can be split between
+    // the cores, along with the reverb output. end_buffer() is called once the whole buffer
+    // is mixed, runs the delay and puts it through the limiter into out as interleaved stereo.
+    void mix(int start, int len);
+    void end_buffer(int16_t *out);
+
+    // Mix all active channel buffers down into the given output buffer
     void downmix(AudioBuffer buffer);
 
+    // Work out the mix coefficients from the volumes and mutes. Called by start_channels().
+    void update_mix_gains();
+
     void set_volume_percent(int vol);
+    void set_channel_volume_percent(int chan, int vol);
+    // -100 (left) to 100 (right)
+    void set_channel_pan_percent(int chan, int pan);
+    void set_reverb_quality(int quality);
+    void set_reverb_decay(float seconds);
     void enable_keyboard(bool en);
 
     bool get_channel_activity(int chan);
@@ -93,6 +194,11 @@ public:
     int bpm;
     int samples_per_step;
     bool is_playing;
+
+    // Send delay, in steps (sixteenth notes) so that it follows the tempo
+    int delay_steps {3};
+    int delay_feedback {40};    // percent
+    int delay_tone {50};        // percent, lower is darker
     
     Channel channels[NUM_CHANNELS];
     int active_channel;
@@ -108,9 +214,37 @@ public:
 
 
 private:
-    int next_note_idx(int channel);
+    // Times the mix and the reverb on a Track of its own
+    friend int dsp_benchmark(int argc, char **argv);
+
+    // Order in which channels are claimed for rendering, and the next one to claim
+    uint8_t channel_order[NUM_CHANNELS];
+    int buffer_samps {DEFAULT_BUFFER_SIZE_SAMPS};
+    volatile uint32_t next_claim;
+    volatile uint32_t channels_done;
+
+    // Per-channel left and right mix gains and send gains, with pan,
+    // master volume and output scaling folded in
+#ifdef AUDIO_Q15
+    int16_t mix_gain[NUM_CHANNELS][2];
+    int16_t send_gain[NUM_CHANNELS][NUM_SENDS];
+#else
+    float mix_gain[NUM_CHANNELS][2];
+    float send_gain[NUM_CHANNELS][NUM_SENDS];
+#endif
+    mix_t mix_acc[2*BUFFER_SIZE_SAMPS];
+    mix_t send_acc[NUM_SENDS][BUFFER_SIZE_SAMPS];
+    Delay delay;
+    Reverb reverb;
+    mix_t reverb_out[2*BUFFER_SIZE_SAMPS];
+    bool reverb_active;
+    Limiter limiter;
+
+    void schedule_step(int chan);
+    // Queue the keyboard releases still waiting for space
+    void release_keys(uint32_t time);
+    int next_step(int stepno);
     int bpm_old;
     float volume {0.0f};
-    bool first_step;
 };
 
@@ -2,6 +2,7 @@
 #include "hw.h"
 #include "track.hpp"
 #include "sample.hpp"
+#include "audio.hpp"
 #include "common.h"
 #include "hw/oled.h"
 #include "gfx/gfx.h"
@@ -47,6 +48,9 @@ InputState inputs {};
 LEDMode led_mode {LEDS_SHOW_CHANNELS};
 int brightness {DEFAULT_BRIGHTNESS};
 int volume_percent {DEFAULT_VOLUME};
+int reverb_quality {REVERB_OFF};
+int reverb_decay {15};      // tenths of a second
+int user_wave {-1};         // sample list index of the user wavetable, -1 for the sine
 bool recording;
 bool screensaver_active;
 bool keys_pressed;
@@ -179,6 +183,9 @@ void TrackView::react(DrawEvent const & devt) {
     led_mode = LEDS_SHOW_CHANNELS;
     ngl_fillscreen(0);
     kmgui_gauge(0, &track.bpm, 5, 240, "$ bpm");
+    kmgui_gauge(1, &track.delay_steps, 1, 16, "Dly $/16");
+    kmgui_gauge(2, &track.delay_feedback, 0, 95, "Fb $%");
+    kmgui_gauge(3, &track.channels[track.active_channel].send[SEND_DELAY], 0, 100, "Snd $%");
     draw_debug_info();
 }
 
@@ -528,6 +535,7 @@ bool process(RawInput in) {
     bool update = false;
 
     track.schedule();   // Run sequencer
+    track.background(); // Load samples asked for by the instruments
 
     if (input_process(&inputs, in)) {
         update = true;
@@ -631,7 +639,7 @@ void draw_debug_info(void) {
     
     // audio CPU usage
     int64_t time_audio_us = perf_get(PERF_AUDIO);
-    float audio_percent = 100.0f * time_audio_us/(1E6 * BUFFER_TIME_SEC);
+    float audio_percent = 100.0f * time_audio_us * SAMPLE_RATE / (1E6f * audio_get_buffer_size());
     ngl_textf(FONT_A, 0,115,0,"%.1f%%",  audio_percent);
 
     //float fps_display = 1E6 / perf_get(PERF_DISPLAY_UPDATE);
@@ -701,6 +709,20 @@ wlListDrawFuncs debug_menu_funcs = {
     .draw_scrollbar = draw_debug_menu_scrollbar
 };
 
+// Take the start of a sample as one cycle of the user wavetable
+static void set_user_wave(int idx) {
+    static int16_t cycle[WT_USER_MAX_LEN];
+    const int id = SampleManager::sample_list[idx].sample_id;
+    SampleInfo *samp = SampleManager::get_info(id);
+    if (!samp) return;
+    if (!samp->is_loaded && SampleManager::load(id) < 0) return;
+
+    int len = samp->length;
+    if (len > WT_USER_MAX_LEN) len = WT_USER_MAX_LEN;
+    SampleManager::fetch_block(id, 0, cycle, len);
+    wavetable_set_user(cycle, len);
+}
+
 void debug_menu() {
 
     wl_list_start("Debug menu", 6, 0, 1, &debug_menu_funcs);
@@ -709,12 +731,76 @@ void debug_menu() {
             track.set_volume_percent(volume_percent);    
         }
     }
+    // Edited in powers of two
+    int buffer_shift = __builtin_ctz(audio_get_buffer_size() / MIN_BUFFER_SIZE_SAMPS);
+    if (wl_list_item_int("Buffer size", audio_get_buffer_size())) {
+        if (wl_list_edit_int(&buffer_shift, 0, __builtin_ctz(BUFFER_SIZE_SAMPS / MIN_BUFFER_SIZE_SAMPS))) {
+            audio_set_buffer_size(MIN_BUFFER_SIZE_SAMPS << buffer_shift);
+        }
+    }
+    if (wl_list_item_int("Reverb quality", reverb_quality)) {
+        if (wl_list_edit_int(&reverb_quality, 0, NUM_REVERB_QUALITY-1)) {
+            track.set_reverb_quality(reverb_quality);
+        }
+    }
+    if (wl_list_item_int("Reverb decay", reverb_decay)) {
+        if (wl_list_edit_int(&reverb_decay, 1, 100)) {
+            track.set_reverb_decay(reverb_decay / 10.0f);
+        }
+    }
+    Channel *chan = &track.channels[track.active_channel];
+    if (wl_list_item_int("Reverb send", chan->send[SEND_REVERB])) {
+        wl_list_edit_int(&chan->send[SEND_REVERB], 0, 100);
+    }
+    if (chan->type == CHANNEL_SAMPLE) {
+        Sampler *sampler = chan->sampler;
+        int voices = sampler->get_max_voices();
+        if (wl_list_item_int("Sample voices", voices)) {
+            if (wl_list_edit_int(&voices, 1, SAMPLER_MAX_VOICES)) {
+                sampler->set_max_voices(voices);
+            }
+        }
+        if (wl_list_item_str("Sample interp", sampler->interp == SAMPLE_INTERP_HERMITE ? "Hermite" : "Linear")) {
+            wl_list_edit_int(&sampler->interp, 0, NUM_SAMPLE_INTERP-1);
+        }
+    }
+    // Playback settings of the selected step's sample
+    SampleInfo *samp = NULL;
+    if (selected_step >= 0 && steps[selected_step].sample_id >= 0) {
+        samp = SampleManager::get_info(steps[selected_step].sample_id);
+    }
+    if (samp && samp->length > 0) {
+        static const char *mode_names[NUM_SAMPLE_MODES] = {"One shot", "Loop", "Reverse"};
+        int mode = samp->mode;
+        if (wl_list_item_str("Sample mode", mode_names[mode])) {
+            if (wl_list_edit_int(&mode, 0, NUM_SAMPLE_MODES-1)) samp->mode = mode;
+        }
+        // Start stays before the end, otherwise nothing would play
+        int start = (uint64_t)samp->start * 100 / samp->length;
+        int end = (uint64_t)samp->end * 100 / samp->length;
+        if (wl_list_item_int("Sample start %", start)) {
+            if (wl_list_edit_int(&start, 0, end - 1)) samp->start = (uint64_t)start * samp->length / 100;
+        }
+        if (wl_list_item_int("Sample end %", end)) {
+            if (wl_list_edit_int(&end, start + 1, 100)) samp->end = (uint64_t)end * samp->length / 100;
+        }
+        int choke = samp->choke_group;
+        if (wl_list_item_int("Choke group", choke)) {
+            if (wl_list_edit_int(&choke, 0, 8)) samp->choke_group = choke;
+        }
+    }
+    const int nsamps = SampleManager::sample_list.size();
+    if (nsamps > 0) {
+        const char *name = (user_wave >= 0) ? SampleManager::sample_list[user_wave].name : "Sine";
+        if (wl_list_item_str("User wave", name)) {
+            if (wl_list_edit_int(&user_wave, 0, nsamps-1)) set_user_wave(user_wave);
+        }
+    }
     if (wl_list_item_int("Brightness", brightness)) {
         if (wl_list_edit_int(&brightness, 0, 10)) {
             set_brightness(brightness);
         }
     }
-    const int nsamps = SampleManager::sample_list.size();
     for (int i=0; i<nsamps; i++) {
         char value[32];
         SampleInfo *samp = &SampleManager::sample_list[i];
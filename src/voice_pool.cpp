@@ -0,0 +1,17 @@
+#include "voice_pool.hpp"
+
+volatile int voices_active;
+volatile int voice_limit {VOICE_LIMIT_MAX};
+
+void voice_limit_update(int64_t audio_us, int n) {
+    const int64_t buffer_us = (int64_t)n * 1000000 / SAMPLE_RATE;
+    const int load = audio_us * 100 / buffer_us;
+
+    // Only give voices back once the ones playing fit comfortably,
+    // so the limit doesn't flip back and forth every buffer
+    if (load > VOICE_LOAD_HIGH && voice_limit > VOICE_LIMIT_MIN) {
+        voice_limit = voices_active - 1 > VOICE_LIMIT_MIN ? voices_active - 1 : VOICE_LIMIT_MIN;
+    } else if (load < VOICE_LOAD_LOW && voice_limit < VOICE_LIMIT_MAX && voices_active >= voice_limit) {
+        voice_limit = voice_limit + 1;
+    }
+}
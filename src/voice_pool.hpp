@@ -0,0 +1,161 @@
+#pragma once
+#include <stdint.h>
+#include "common.h"
+
+// Fixed pools of voices for polyphonic instruments.
+//
+// The voices are part of the instrument, so nothing is allocated at runtime.
+// A Voice type needs:
+//      int midi_note;
+//      bool gate;
+//      bool is_idle();     // silent until it is started again
+//      float level();      // current output level, used to pick a voice to steal
+//
+// The number of voices playing across all pools is capped by voice_limit, which
+// is adjusted from the measured audio callback time (see voice_limit_update).
+
+
+
+// Voice cap limits. Each pool can always play at least one voice.
+#define VOICE_LIMIT_MIN 2
+#define VOICE_LIMIT_MAX 16
+
+// Audio callback time (% of the buffer period) above which voices are taken
+// away, and below which they are given back
+#define VOICE_LOAD_HIGH 80
+#define VOICE_LOAD_LOW  60
+
+// Voices playing across all pools, and how many are allowed to play
+extern volatile int voices_active;
+extern volatile int voice_limit;
+
+// Adjust voice_limit given the time (us) taken by the last audio callback, for a
+// buffer of n samples
+void voice_limit_update(int64_t audio_us, int n);
+
+
+
+template <typename Voice, int N>
+class VoicePool {
+public:
+    Voice voices[N];
+
+    void init() {
+        for (int i=0; i<N; i++) {
+            if (active[i]) __atomic_fetch_sub(&voices_active, 1, __ATOMIC_RELAXED);
+            voices[i].gate = false;
+            voices[i].midi_note = -1;
+            active[i] = false;
+            age[i] = 0;
+        }
+        counter = 0;
+    }
+
+    // Get a voice to play the note. A voice already playing the same note is
+    // reused, then a free voice if the cap allows, otherwise one is stolen.
+    // The caller sets the voice up and opens its gate.
+    Voice *note_on(int note) {
+        int v = find(note);
+        if (v < 0) v = find_free();
+        if (v < 0) v = find_steal();
+
+        if (!active[v]) {
+            active[v] = true;
+            __atomic_fetch_add(&voices_active, 1, __ATOMIC_RELAXED);
+        }
+        age[v] = ++counter;
+        voices[v].midi_note = note;
+        return &voices[v];
+    }
+
+    void note_off(int note) {
+        for (int i=0; i<N; i++) {
+            if (active[i] && voices[i].midi_note == note) voices[i].gate = false;
+        }
+    }
+
+    void release_all() {
+        for (int i=0; i<N; i++) voices[i].gate = false;
+    }
+
+    bool is_active(int v) { return active[v]; }
+
+    bool is_idle() {
+        for (int i=0; i<N; i++) {
+            if (active[i]) return false;
+        }
+        return true;
+    }
+
+    // Call after rendering a block to return voices which have finished.
+    // If over the global cap, the oldest held voice is released to shed load.
+    // Voices already releasing are left out, as they will be gone soon.
+    void update() {
+        int held = 0;
+        int releasing = 0;
+        int oldest = -1;
+        for (int i=0; i<N; i++) {
+            if (!active[i]) continue;
+            if (voices[i].is_idle()) {
+                active[i] = false;
+                __atomic_fetch_sub(&voices_active, 1, __ATOMIC_RELAXED);
+            } else if (!voices[i].gate) {
+                releasing++;
+            } else {
+                held++;
+                if (oldest < 0 || (int32_t)(age[i] - age[oldest]) < 0) oldest = i;
+            }
+        }
+
+        if (held > 1 && voices_active - releasing > voice_limit) {
+            voices[oldest].gate = false;
+        }
+    }
+
+private:
+    bool active[N];
+    uint32_t age[N];        // note_on order, for oldest-first stealing
+    uint32_t counter;
+
+    int find(int note) {
+        for (int i=0; i<N; i++) {
+            if (active[i] && voices[i].midi_note == note) return i;
+        }
+        return -1;
+    }
+
+    int find_free() {
+        int count = 0;
+        for (int i=0; i<N; i++) {
+            if (active[i]) count++;
+        }
+        // Over the global cap, this pool has to make do with the voices it has
+        if (count > 0 && voices_active >= voice_limit) return -1;
+
+        for (int i=0; i<N; i++) {
+            if (!active[i]) return i;
+        }
+        return -1;
+    }
+
+    // Steal the quietest released voice, or if all are held, the oldest
+    int find_steal() {
+        int best = -1;
+        float best_level = 0.0f;
+        for (int i=0; i<N; i++) {
+            if (!active[i] || voices[i].gate) continue;
+            float level = voices[i].level();
+            if (best < 0 || level < best_level) {
+                best = i;
+                best_level = level;
+            }
+        }
+        if (best >= 0) return best;
+
+        for (int i=0; i<N; i++) {
+            if (!active[i]) continue;
+            if (best < 0 || (int32_t)(age[i] - age[best]) < 0) best = i;
+        }
+        return best;
+    }
+};
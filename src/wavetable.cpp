@@ -0,0 +1,127 @@
+#include <math.h>
+#include <string.h>
+#include "wavetable.hpp"
+#include "dsp_q15.hpp"
+
+const char *wavetable_names[NUM_WAVETABLES] = {"Saw", "Square", "Triangle", "User"};
+
+// One extra sample at the end of each table so interpolation doesn't need to wrap
+static int16_t tables[NUM_WAVETABLES][WT_LEVELS][WT_SIZE + 1];
+
+static float sine[WT_SIZE];
+static float work[WT_SIZE];
+
+// Harmonic amplitudes for the table being built, index 0 unused
+static float sin_amp[WT_MAX_HARMONICS + 1];
+static float cos_amp[WT_MAX_HARMONICS + 1];
+
+
+static int level_harmonics(int level) {
+    int h = (1 << (WT_BITS - 1)) >> level;
+    return (h > WT_MAX_HARMONICS) ? WT_MAX_HARMONICS : h;
+}
+
+// Fill in all levels of a table from sin_amp/cos_amp. Every level is scaled by
+// the peak of level 0, so the loudness doesn't jump between octaves.
+static void build_table(int table) {
+    float scale = 1.0f;
+
+    for (int level=0; level<WT_LEVELS; level++) {
+        const int harmonics = level_harmonics(level);
+
+        float peak = 0.0f;
+        for (int i=0; i<WT_SIZE; i++) {
+            float sum = 0.0f;
+            for (int h=1; h<=harmonics; h++) {
+                const int idx = (i * h) & (WT_SIZE - 1);
+                sum += sin_amp[h] * sine[idx] + cos_amp[h] * sine[(idx + WT_SIZE/4) & (WT_SIZE - 1)];
+            }
+            work[i] = sum;
+            if (fabsf(sum) > peak) peak = fabsf(sum);
+        }
+        if (level == 0 && peak > 0.0f) scale = 0.999f / peak;
+
+        int16_t *t = tables[table][level];
+        for (int i=0; i<WT_SIZE; i++) {
+            t[i] = q15_from_float(work[i] * scale);
+        }
+        t[WT_SIZE] = t[0];
+    }
+}
+
+void wavetable_init(void) {
+    for (int i=0; i<WT_SIZE; i++) {
+        sine[i] = sinf(2.0f * (float)M_PI * i / WT_SIZE);
+    }
+
+    // Rising saw, to match oscillator_saw
+    memset(cos_amp, 0, sizeof(cos_amp));
+    for (int h=1; h<=WT_MAX_HARMONICS; h++) {
+        sin_amp[h] = -1.0f / h;
+    }
+    build_table(WT_SAW);
+
+    for (int h=1; h<=WT_MAX_HARMONICS; h++) {
+        sin_amp[h] = (h & 1) ? 1.0f / h : 0.0f;
+    }
+    build_table(WT_SQUARE);
+
+    for (int h=1; h<=WT_MAX_HARMONICS; h++) {
+        sin_amp[h] = (h & 1) ? ((h & 2) ? -1.0f : 1.0f) / (h * h) : 0.0f;
+    }
+    build_table(WT_TRI);
+
+    memset(sin_amp, 0, sizeof(sin_amp));
+    sin_amp[1] = 1.0f;
+    build_table(WT_USER);
+}
+
+void wavetable_set_user(const int16_t *cycle, int len) {
+    if (len < 2) return;
+    if (len > WT_USER_MAX_LEN) len = WT_USER_MAX_LEN;
+
+    // Naive DFT: only done once per table, and len is small. The sine table is
+    // exact when len is WT_SIZE, and close enough for other lengths.
+    int harmonics = len/2 - 1;
+    if (harmonics > WT_MAX_HARMONICS) harmonics = WT_MAX_HARMONICS;
+
+    memset(sin_amp, 0, sizeof(sin_amp));
+    memset(cos_amp, 0, sizeof(cos_amp));
+    for (int h=1; h<=harmonics; h++) {
+        float s = 0.0f;
+        float c = 0.0f;
+        for (int i=0; i<len; i++) {
+            const int idx = (h * i * WT_SIZE / len) & (WT_SIZE - 1);
+            s += cycle[i] * sine[idx];
+            c += cycle[i] * sine[(idx + WT_SIZE/4) & (WT_SIZE - 1)];
+        }
+        sin_amp[h] = s;
+        cos_amp[h] = c;
+    }
+    build_table(WT_USER);
+}
+
+
+static inline int wavetable_level(uint32_t dphase) {
+    int level = (31 - __builtin_clz(dphase | 1)) - WT_LEVEL0_BITS;
+    if (level < 0) return 0;
+    if (level >= WT_LEVELS) return WT_LEVELS - 1;
+    return level;
+}
+
+void wavetable_block(int16_t *out, int table, uint32_t *phase, uint32_t dphase, int n) {
+    const int16_t *t = tables[table][wavetable_level(dphase)];
+    uint32_t p = *phase;
+
+    // Linear interpolation between table samples, with a 15 bit fraction
+    for (int i=0; i<n; i++) {
+        p += dphase;
+        const uint32_t idx = p >> (32 - WT_BITS);
+        const int32_t frac = (p >> (32 - WT_BITS - 15)) & 0x7FFF;
+        const int32_t a = t[idx];
+        const int32_t b = t[idx + 1];
+        out[i] = a + (((b - a) * frac) >> 15);
+    }
+
+    *phase = p;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <stdint.h>
+
+// Band-limited wavetable oscillators.
+//
+// Each waveform is stored as a set of single cycle tables, one per octave,
+// with only the harmonics that stay below Nyquist anywhere in that octave.
+// The tables are built by additive synthesis in wavetable_init() and kept in SRAM,
+// as PSRAM is far too slow for per-sample random access.
+
+#define WT_BITS 9
+#define WT_SIZE (1 << WT_BITS)
+
+// Level 0 is used for phase increments up to 2^(WT_LEVEL0_BITS+1), which is about
+// 94 Hz, and has the most harmonics a table of WT_SIZE samples can hold. Each level
+// above covers one octave more, with half the harmonics.
+#define WT_LEVEL0_BITS 22
+#define WT_LEVELS 9
+#define WT_MAX_HARMONICS (WT_SIZE/2 - 1)
+
+enum Wavetable {
+    WT_SAW,
+    WT_SQUARE,
+    WT_TRI,
+    WT_USER,        // set with wavetable_set_user(), a sine until then
+    NUM_WAVETABLES
+};
+
+extern const char *wavetable_names[NUM_WAVETABLES];
+
+// Build all tables. Called by create_lookup_tables().
+void wavetable_init(void);
+
+// Longest cycle for the user table. It has all the harmonics a table can hold.
+#define WT_USER_MAX_LEN WT_SIZE
+
+// Replace the user table with a single cycle waveform of len samples, up to
+// WT_USER_MAX_LEN. Takes a few ms, so call from the main loop.
+void wavetable_set_user(const int16_t *cycle, int len);
+
+// Render n full scale Q15 samples, advancing phase by dphase (from note_table) per sample
+void wavetable_block(int16_t *out, int table, uint32_t *phase, uint32_t dphase, int n);
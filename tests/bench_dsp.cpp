@@ -0,0 +1,63 @@
+// Host timings for the per-sample cost of the instruments and effects, as a
+// rough guide between runs of dspbench on the device. Times are ns per sample
+// on this machine, so only compare them with each other.
+#include <stdio.h>
+#include <chrono>
+#include "instrument.hpp"
+#include "reverb.hpp"
+
+// Each case is run over this many buffers
+#define BENCH_REPEATS 2000
+
+static sample_t chan_buf[BUFFER_SIZE_SAMPS];
+static mix_t send[BUFFER_SIZE_SAMPS];
+static mix_t stereo_out[2*BUFFER_SIZE_SAMPS];
+
+template <typename F>
+static void bench(const char *name, F func) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int r=0; r<BENCH_REPEATS; r++) {
+        func();
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    printf("  %-16s %6.1f ns/sample\n", name, elapsed.count() / (BENCH_REPEATS * BUFFER_SIZE_SAMPS));
+}
+
+int main() {
+    create_lookup_tables();
+#ifdef AUDIO_Q15
+    printf("Q15:\n");
+#else
+    printf("float:\n");
+#endif
+
+    static AcidBass acid;
+    acid.init();
+    acid.note_on(45, false, true);
+    bench("AcidBass", [&]() {
+        acid.process_block(chan_buf, BUFFER_SIZE_SAMPS);
+    });
+
+    // Every drum sounding at once, retriggered so none of them decay away
+    static DrumSynth drums;
+    drums.init();
+    bench("DrumSynth all", [&]() {
+        for (int note : {36, 38, 39, 46}) drums.note_on(note, true, true);
+        drums.process_block(chan_buf, BUFFER_SIZE_SAMPS);
+    });
+
+    // The send is the drum output from above
+    for (int i=0; i<BUFFER_SIZE_SAMPS; i++) send[i] = chan_buf[i];
+    static Reverb reverb;
+    reverb.init();
+    reverb.set_quality(REVERB_LOW);
+    bench("reverb low", [&]() {
+        reverb.process(send, stereo_out, BUFFER_SIZE_SAMPS);
+    });
+    reverb.set_quality(REVERB_HIGH);
+    bench("reverb high", [&]() {
+        reverb.process(send, stereo_out, BUFFER_SIZE_SAMPS);
+    });
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+// Run q15_fm_op_block on random phases, steps, modulation and feedback.
+//   fm_op OUT                  writes the output of the plain C version
+//   fm_op_interp OUT REF       runs the interpolator version against a model of
+//                              interp1 and checks it matches REF exactly
+// Each block writes its samples, then the phase and feedback state after it.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_q15.hpp"
+
+#define NUM_BLOCKS 2000
+#define MAX_BLOCK 256
+#define BLOCK_WORDS (MAX_BLOCK + 4)
+
+static int16_t rendered[NUM_BLOCKS][BLOCK_WORDS];
+
+// Fixed sequence, so both builds see the same input
+static uint32_t rng_state = 12345;
+static uint32_t rng() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void render() {
+    static uint32_t mod[MAX_BLOCK];
+    for (int b=0; b<NUM_BLOCKS; b++) {
+        int16_t *dst = rendered[b];
+        const int n = 1 + rng() % MAX_BLOCK;
+        uint32_t phase = rng();
+        const uint32_t dphase = rng() >> (rng() % 16);
+        // Half the blocks without feedback, which takes the other loop
+        const int16_t fb = (b & 1) ? (int16_t)rng() : 0;
+        int16_t fb_state[2] = {(int16_t)rng(), (int16_t)rng()};
+        // Modulation from none up to full scale phase offsets
+        const int mod_shift = rng() % 33;
+        for (int i=0; i<n; i++) mod[i] = (mod_shift == 32) ? 0 : rng() >> mod_shift;
+
+        memset(dst, 0, BLOCK_WORDS * sizeof(int16_t));
+        q15_fm_op_block(dst, mod, &phase, dphase, fb, fb_state, n);
+        dst[MAX_BLOCK] = phase >> 16;
+        dst[MAX_BLOCK+1] = phase & 0xffff;
+        dst[MAX_BLOCK+2] = fb_state[0];
+        dst[MAX_BLOCK+3] = fb_state[1];
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s OUT [REF]\n", argv[0]);
+        return 2;
+    }
+
+    render();
+
+    FILE *f = fopen(argv[1], "wb");
+    if (!f || fwrite(rendered, sizeof(rendered), 1, f) != 1) {
+        fprintf(stderr, "can't write %s\n", argv[1]);
+        return 2;
+    }
+    fclose(f);
+
+    if (argc < 3) return 0;
+
+    static int16_t ref[NUM_BLOCKS][BLOCK_WORDS];
+    f = fopen(argv[2], "rb");
+    if (!f || fread(ref, sizeof(ref), 1, f) != 1) {
+        fprintf(stderr, "can't read %s\n", argv[2]);
+        return 2;
+    }
+    fclose(f);
+
+    for (int b=0; b<NUM_BLOCKS; b++) {
+        for (int i=0; i<BLOCK_WORDS; i++) {
+            if (rendered[b][i] != ref[b][i]) {
+                printf("FAIL: block %d word %d is %d, expected %d\n", b, i, rendered[b][i], ref[b][i]);
+                return 1;
+            }
+        }
+    }
+    printf("%d blocks match\n", NUM_BLOCKS);
+    return 0;
+}
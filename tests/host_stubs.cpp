@@ -0,0 +1,17 @@
+// Stand-ins for the parts of the firmware the DSP tests link against but
+// never exercise: the sample storage used by Granular.
+#include "sample.hpp"
+
+namespace SampleManager {
+
+std::vector<SampleInfo> sample_list;
+
+int load(int sample_id) { return -1; }
+
+SampleInfo *get_info(int sample_id) { return NULL; }
+
+void fetch_block(int sample_id, int pos, int16_t *buf, int n) {
+    for (int i=0; i<n; i++) buf[i] = 0;
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+// Software model of an RP2350 SIO interpolator, standing in for hardware/interp.h
+// so the interp1 code in dsp_q15.cpp can be run on the host. Only the parts that
+// code uses are modelled: per lane SHIFT, MASK_LSB/MASK_MSB and ADD_RAW (lane 0),
+// the lane and FULL results, and the accumulator update on a pop.
+//
+//   LANEn  = BASEn + (ADD_RAW ? ACCUMn : (ACCUMn >> SHIFT) & MASK)
+//   FULL   = BASE2 + the two shifted and masked lanes (ADD_RAW doesn't apply)
+//   POPn   reads a result and writes LANE0 and LANE1 back to ACCUM0 and ACCUM1
+//
+// BASE2 and FULL are pointer sized here, so a table address survives on a
+// 64-bit host.
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+typedef struct {
+    uint shift;
+    uint mask_lsb;
+    uint mask_msb;
+    bool add_raw;
+} interp_config;
+
+struct interp_hw_t;
+
+// Reading one of these pops the interpolator, as reading the POP registers does
+class InterpPop {
+public:
+    uintptr_t read() const;
+    operator uint32_t() const { return (uint32_t)read(); }
+    template <typename T> explicit operator T*() const { return (T*)read(); }
+
+    interp_hw_t *hw;
+    int idx;
+};
+
+struct interp_hw_t {
+    uint32_t accum[2];
+    uintptr_t base[3];
+    InterpPop pop[3];
+    interp_config lane[2];
+
+    uint32_t masked(int l) const {
+        const interp_config &c = lane[l];
+        const uint32_t mask = (uint32_t)((2ull << c.mask_msb) - (1ull << c.mask_lsb));
+        return (accum[l] >> c.shift) & mask;
+    }
+    uintptr_t result(int l) const {
+        return base[l] + (lane[l].add_raw ? accum[l] : masked(l));
+    }
+    uintptr_t full() const {
+        return base[2] + masked(0) + masked(1);
+    }
+};
+
+inline uintptr_t InterpPop::read() const {
+    const uintptr_t r[3] = {hw->result(0), hw->result(1), hw->full()};
+    hw->accum[0] = (uint32_t)r[0];
+    hw->accum[1] = (uint32_t)r[1];
+    return r[idx];
+}
+
+inline interp_hw_t interp1_emu {
+    {0, 0}, {0, 0, 0},
+    {{&interp1_emu, 0}, {&interp1_emu, 1}, {&interp1_emu, 2}},
+    {},
+};
+#define interp1 (&interp1_emu)
+
+static inline interp_config interp_default_config() {
+    interp_config c {};
+    c.mask_msb = 31;
+    return c;
+}
+
+static inline void interp_config_set_shift(interp_config *c, uint shift) { c->shift = shift; }
+
+static inline void interp_config_set_mask(interp_config *c, uint mask_lsb, uint mask_msb) {
+    c->mask_lsb = mask_lsb;
+    c->mask_msb = mask_msb;
+}
+
+static inline void interp_config_set_add_raw(interp_config *c, bool add_raw) { c->add_raw = add_raw; }
+
+static inline void interp_set_config(interp_hw_t *interp, uint lane, interp_config *config) {
+    interp->lane[lane] = *config;
+}
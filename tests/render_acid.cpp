@@ -0,0 +1,104 @@
+// Render a fixed AcidBass pattern.
+//   render_acid_float OUT          writes the floating point reference
+//   render_acid OUT REF            renders with the Q15 kernels and checks it against REF
+// Samples are written as float, with a channel's full scale at 1.0.
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "instrument.hpp"
+
+// Largest difference allowed between the paths, in LSB of 16-bit output with
+// a channel's full scale mapped to the output's, and the smallest signal to
+// error ratio. The noise steps are quieter than the rest, with about the same
+// error, which brings the ratio down.
+#define MAX_DIFF_LSB 72
+#define MIN_SNR_DB 64.0
+
+#define NUM_STEPS 32
+#define STEP_SAMPS 6000
+#define NUM_SAMPS (NUM_STEPS * STEP_SAMPS)
+
+static float rendered[NUM_SAMPS];
+
+static void render(float *dst) {
+    static AcidBass acid;
+    acid.init();
+
+    const int notes[16] = {36,36,48,36,43,36,46,48,36,39,36,48,41,36,43,46};
+    const int waves[4] = {WAVE_SQUARE, WAVE_NOISE, WAVE_PINK_NOISE, WAVE_SH_NOISE};
+    static sample_t buf[BUFFER_SIZE_SAMPS];
+    InputState in {};
+    int pos = 0;
+    for (int step=0; step<NUM_STEPS; step++) {
+        // Sweep the filter up across the pattern. The second half changes waveform
+        // every four steps, through the square and the noise sources.
+        in.knob_delta[0] = 3;
+        acid.control(INSTRUMENT_PAGE_FILTER, &in);
+        if (step >= NUM_STEPS/2 && step % 4 == 0) {
+            const int wave = waves[(step - NUM_STEPS/2) / 4];
+            acid.set_param(AB_PARAM_WAVE, (wave * PARAM_SCALE + NUM_WAVE - 1) / NUM_WAVE);
+        }
+        if (step % 4 != 3) {
+            acid.note_freq = midi_note_to_freq(notes[step % 16]);
+            acid.accent = (step % 5 == 0);
+            acid.gate = 1;
+            if (step % 2 == 0) acid.trigger = 1;
+        }
+
+        // Blocks of different sizes, with the note off part way through a step
+        int left = STEP_SAMPS;
+        int n = 32 << (step % 4);
+        while (left > 0) {
+            if (left < n) n = left;
+            if (left == STEP_SAMPS/4) acid.gate = 0;
+            acid.process_block(buf, n);
+            for (int i=0; i<n; i++) {
+#ifdef AUDIO_Q15
+                dst[pos++] = buf[i] / (float)Q15_CHANNEL_ONE;
+#else
+                dst[pos++] = buf[i];
+#endif
+            }
+            left -= n;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    create_lookup_tables();
+    render(rendered);
+
+    FILE *f = fopen(argv[1], "wb");
+    if (!f || fwrite(rendered, sizeof(float), NUM_SAMPS, f) != NUM_SAMPS) {
+        printf("can't write %s\n", argv[1]);
+        return 1;
+    }
+    fclose(f);
+
+#ifdef AUDIO_Q15
+    static float ref[NUM_SAMPS];
+    f = fopen(argv[2], "rb");
+    if (!f || fread(ref, sizeof(float), NUM_SAMPS, f) != NUM_SAMPS) {
+        printf("can't read %s\n", argv[2]);
+        return 1;
+    }
+    fclose(f);
+
+    // Compare as 16-bit output: a channel at full scale drives the output to full scale
+    double signal = 0, error = 0, max_diff = 0;
+    for (int i=0; i<NUM_SAMPS; i++) {
+        const double x = ref[i] * 32768.0;
+        const double d = fabs(rendered[i] * 32768.0 - x);
+        signal += x * x;
+        error += d * d;
+        if (d > max_diff) max_diff = d;
+    }
+    const double snr = 10.0 * log10(signal / error);
+    printf("max difference %.1f LSB, SNR %.1f dB\n", max_diff, snr);
+    if (max_diff > MAX_DIFF_LSB || snr < MIN_SNR_DB) {
+        printf("FAIL: limits are %d LSB, %.0f dB\n", MAX_DIFF_LSB, MIN_SNR_DB);
+        return 1;
+    }
+#endif
+    return 0;
+}